@@ -0,0 +1,244 @@
+// Benchmark driver: lexes each input in every requested mode and prints
+// the results as JSON on stdout.
+//
+//   bench [--warmup N] [--reps N] [--modes dfa,switch,direct] [-l rules] file...
+//
+// Each (file, mode) pair runs in its own child process so that its peak
+// RSS is not mixed up with the others. Timings cover lexing only; the
+// file is loaded and the rules compiled before the clock starts.
+//
+// Before timing direct mode the driver checks that its token stream is
+// identical to the interpreted DFA's and fails the run if it is not.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../src/include/lexer.h"
+#include "../src/include/scan.h"
+
+using namespace std;
+
+struct BenchOptions {
+    int warmup = 2;
+    int reps = 10;
+    vector<string> modes = {"dfa", "switch", "direct"};
+    string rules = "rules/pascal_lexicon.dfa";
+};
+
+static bool parseMode(const string& name, LexerMode& mode) {
+    if (name == "dfa") mode = DFA_MODE;
+    else if (name == "switch") mode = SWITCH_MODE;
+    else if (name == "direct") mode = DIRECT_MODE;
+    else return false;
+    return true;
+}
+
+static size_t lexOnce(const Lexer& lexer, const SourceBuffer& source) {
+    size_t tokens = 0;
+    for (const TokenView& token : lexer.tokens(source)) {
+        (void)token;
+        tokens++;
+    }
+    return tokens;
+}
+
+// First difference between two token streams, or -1
+static long firstMismatch(const TokenStream& a, const TokenStream& b) {
+    size_t count = min(a.size(), b.size());
+    for (size_t i = 0; i < count; i++) {
+        if (a.getType(i) != b.getType(i) || a.getOffset(i) != b.getOffset(i) ||
+            a.getLength(i) != b.getLength(i) || a.getText(i) != b.getText(i)) {
+            return (long)i;
+        }
+    }
+    return a.size() == b.size() ? -1 : (long)count;
+}
+
+// Nearest-rank percentile of sorted samples
+static double percentile(const vector<double>& sorted, double p) {
+    size_t rank = (size_t)(p / 100.0 * sorted.size() + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > sorted.size()) rank = sorted.size();
+    return sorted[rank - 1];
+}
+
+static void jsonString(string& out, const string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    out += '"';
+}
+
+// Runs in the child; returns one JSON object
+static string runCase(const string& file, const string& modeName, const BenchOptions& options) {
+    LexerMode mode;
+    parseMode(modeName, mode);
+
+    SourceBuffer source;
+    if (!source.loadFile(file.c_str())) {
+        exit(2);
+    }
+    Lexer lexer(mode, options.rules);
+
+    size_t tokens = 0;
+    for (int i = 0; i < options.warmup; i++) {
+        tokens = lexOnce(lexer, source);
+    }
+    vector<double> seconds;
+    for (int i = 0; i < options.reps; i++) {
+        auto start = chrono::steady_clock::now();
+        tokens = lexOnce(lexer, source);
+        auto end = chrono::steady_clock::now();
+        seconds.push_back(chrono::duration<double>(end - start).count());
+    }
+    sort(seconds.begin(), seconds.end());
+
+    double mean = 0;
+    for (double s : seconds) mean += s;
+    mean /= seconds.size();
+    double median = percentile(seconds, 50);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    char buffer[1024];
+    string out = "    {\"file\": ";
+    jsonString(out, file);
+    snprintf(buffer, sizeof(buffer),
+             ", \"mode\": \"%s\", \"bytes\": %zu, \"tokens\": %zu,\n"
+             "     \"seconds\": {\"min\": %.6f, \"p50\": %.6f, \"p90\": %.6f, \"p99\": %.6f, \"max\": %.6f, \"mean\": %.6f},\n"
+             "     \"mb_per_s\": %.2f, \"tokens_per_s\": %.0f, \"peak_rss_kb\": %ld}",
+             modeName.c_str(), source.size(), tokens,
+             seconds.front(), median, percentile(seconds, 90), percentile(seconds, 99), seconds.back(), mean,
+             source.size() / median / 1e6, tokens / median, (long)usage.ru_maxrss);
+    out += buffer;
+    return out;
+}
+
+// Runs in its own child so the token streams do not count towards peak RSS
+static string verifyDirect(const string& file, const BenchOptions& options) {
+    SourceBuffer source;
+    if (!source.loadFile(file.c_str())) {
+        exit(2);
+    }
+    Lexer direct(DIRECT_MODE, options.rules);
+    Lexer reference(DFA_MODE, options.rules);
+    long mismatch = firstMismatch(direct.lex(source), reference.lex(source));
+    if (mismatch >= 0) {
+        fprintf(stderr, "bench: %s: direct lexer differs from the DFA at token %ld\n", file.c_str(), mismatch);
+        exit(4);
+    }
+    return "";
+}
+
+// Fork, run work in the child and collect the string it returns through a pipe
+template <typename Work>
+static bool runIsolated(Work work, string& result) {
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+    fflush(stdout);
+
+    pid_t child = fork();
+    if (child < 0) return false;
+    if (child == 0) {
+        close(fds[0]);
+        string json = work();
+        size_t done = 0;
+        while (done < json.size()) {
+            ssize_t n = write(fds[1], json.data() + done, json.size() - done);
+            if (n <= 0) _exit(3);
+            done += (size_t)n;
+        }
+        _exit(0);
+    }
+
+    close(fds[1]);
+    char buffer[4096];
+    ssize_t n;
+    result.clear();
+    while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+        result.append(buffer, (size_t)n);
+    }
+    close(fds[0]);
+    int status;
+    waitpid(child, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--warmup N] [--reps N] [--modes dfa,switch,direct] [-l rules] file...\n", program);
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    vector<string> files;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--warmup") == 0 && has_value) {
+            options.warmup = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--reps") == 0 && has_value) {
+            options.reps = max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--modes") == 0 && has_value) {
+            options.modes.clear();
+            string list = argv[++i];
+            size_t start = 0;
+            while (start <= list.size()) {
+                size_t comma = list.find(',', start);
+                if (comma == string::npos) comma = list.size();
+                string name = list.substr(start, comma - start);
+                LexerMode mode;
+                if (!parseMode(name, mode)) {
+                    fprintf(stderr, "Unknown mode: %s\n", name.c_str());
+                    return 1;
+                }
+                options.modes.push_back(name);
+                start = comma + 1;
+            }
+        } else if (strcmp(argv[i], "-l") == 0 && has_value) {
+            options.rules = argv[++i];
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("{\n  \"scanner\": \"%s\", \"warmup\": %d, \"reps\": %d,\n  \"results\": [\n",
+           scanLevel(), options.warmup, options.reps);
+    bool first = true;
+    int failures = 0;
+    for (const string& file : files) {
+        for (const string& mode : options.modes) {
+            string result;
+            if (mode == "direct" && !runIsolated([&] { return verifyDirect(file, options); }, result)) {
+                failures++;
+                continue;
+            }
+            if (!runIsolated([&] { return runCase(file, mode, options); }, result)) {
+                fprintf(stderr, "bench: %s in %s mode failed\n", file.c_str(), mode.c_str());
+                failures++;
+                continue;
+            }
+            printf("%s%s", first ? "" : ",\n", result.c_str());
+            first = false;
+        }
+    }
+    printf("\n  ]\n}\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+// Deterministic Pascal-S corpus generator for the benchmarks.
+//
+//   gen_corpus --size 64M --mix comment --seed 42 -o corpus.pas
+//
+// The same seed, size and mix always produce the same bytes, on any
+// platform: the generator uses its own PRNG instead of <random>
+// distributions, whose output is implementation-defined.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace std;
+
+// splitmix64
+struct Rng {
+    uint64_t state;
+
+    explicit Rng(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    // Uniform in [0, bound)
+    uint32_t below(uint32_t bound) { return (uint32_t)((next() >> 32) * bound >> 32); }
+    uint32_t range(uint32_t low, uint32_t high) { return low + below(high - low + 1); }
+};
+
+// Relative weight of each statement kind
+struct Mix {
+    const char* name;
+    unsigned identifiers;
+    unsigned comments;
+    unsigned literals;
+    unsigned operators;
+};
+
+static const Mix MIXES[] = {
+    {"ident",    70, 5, 5, 20},
+    {"comment",  15, 70, 5, 10},
+    {"literal",  15, 5, 70, 10},
+    {"operator", 15, 5, 5, 75},
+    {"mixed",    35, 20, 20, 25},
+};
+
+static const char* const WORDS[] = {
+    "counter", "total", "result", "index", "value", "buffer", "offset", "limit",
+    "temp", "flag", "done", "current_char", "message", "name", "left", "right",
+    "node", "count", "sum", "average", "maximum", "minimum", "position", "length"
+};
+static const char* const KEYWORDS_AS_TEXT[] = {
+    "the", "lexer", "reads", "each", "token", "of", "this", "generated", "program",
+    "and", "checks", "that", "nothing", "breaks", "when", "input", "grows"
+};
+static const char* const OPERATORS[] = {
+    "+", "-", "*", "/", "div", "mod", "and", "or"
+};
+static const char* const RELATIONS[] = {
+    "=", "<>", "<", "<=", ">", ">="
+};
+
+class Generator {
+private:
+    Rng rng;
+    const Mix& mix;
+    FILE* out;
+    string line;
+    uint64_t written;
+
+    const char* pick(const char* const* items, size_t count) { return items[rng.below((uint32_t)count)]; }
+
+    void identifier() {
+        line += pick(WORDS, sizeof(WORDS) / sizeof(WORDS[0]));
+        if (rng.below(3) == 0) {
+            line += '_';
+            line += to_string(rng.below(1000));
+        }
+    }
+
+    void operand() {
+        switch (rng.below(4)) {
+            case 0: line += to_string(rng.below(100000)); break;
+            case 1: line += to_string(rng.below(1000)) + "." + to_string(rng.below(100)); break;
+            default: identifier(); break;
+        }
+    }
+
+    void expression(int depth) {
+        int terms = (int)rng.range(1, 4);
+        for (int i = 0; i < terms; i++) {
+            if (i > 0) {
+                line += ' ';
+                line += pick(OPERATORS, sizeof(OPERATORS) / sizeof(OPERATORS[0]));
+                line += ' ';
+            }
+            if (depth < 3 && rng.below(4) == 0) {
+                line += '(';
+                expression(depth + 1);
+                line += ')';
+            } else {
+                operand();
+            }
+        }
+    }
+
+    void words(int count) {
+        for (int i = 0; i < count; i++) {
+            if (i > 0) line += ' ';
+            line += pick(KEYWORDS_AS_TEXT, sizeof(KEYWORDS_AS_TEXT) / sizeof(KEYWORDS_AS_TEXT[0]));
+        }
+    }
+
+    void identifierStatement() {
+        line += "  ";
+        identifier();
+        line += " := ";
+        identifier();
+        for (int i = (int)rng.range(1, 6); i > 0; i--) {
+            line += " + ";
+            identifier();
+        }
+        line += ";\n";
+    }
+
+    void commentStatement() {
+        if (rng.below(2) == 0) {
+            line += "  { ";
+            words((int)rng.range(3, 24));
+            line += " }\n";
+        } else {
+            line += "  (* ";
+            for (int i = (int)rng.range(1, 6); i > 0; i--) {
+                words((int)rng.range(4, 12));
+                line += "\n     ";
+            }
+            line += "*)\n";
+        }
+    }
+
+    void literalStatement() {
+        line += "  ";
+        identifier();
+        if (rng.below(3) == 0) {
+            line += " := '";
+            line += (char)('a' + rng.below(26));
+            line += "';\n";
+        } else {
+            line += " := '";
+            words((int)rng.range(1, 10));
+            line += "';\n";
+        }
+    }
+
+    void operatorStatement() {
+        line += "  if ";
+        expression(0);
+        line += ' ';
+        line += pick(RELATIONS, sizeof(RELATIONS) / sizeof(RELATIONS[0]));
+        line += ' ';
+        expression(0);
+        line += " then ";
+        identifier();
+        line += " := ";
+        expression(0);
+        line += ";\n";
+    }
+
+    void statement() {
+        unsigned total = mix.identifiers + mix.comments + mix.literals + mix.operators;
+        unsigned roll = rng.below(total);
+        if (roll < mix.identifiers) {
+            identifierStatement();
+        } else if ((roll -= mix.identifiers) < mix.comments) {
+            commentStatement();
+        } else if ((roll -= mix.comments) < mix.literals) {
+            literalStatement();
+        } else {
+            operatorStatement();
+        }
+    }
+
+    void flush() {
+        fwrite(line.data(), 1, line.size(), out);
+        written += line.size();
+        line.clear();
+    }
+
+public:
+    Generator(uint64_t seed, const Mix& mix, FILE* out) : rng(seed), mix(mix), out(out), written(0) {}
+
+    void run(uint64_t size) {
+        line += "program Generated;\n\nvar\n";
+        for (const char* word : WORDS) {
+            line += "  ";
+            line += word;
+            line += ": integer;\n";
+        }
+        line += "\nbegin\n";
+        const char* footer = "end.\n";
+        while (written + line.size() + strlen(footer) < size) {
+            statement();
+            if (line.size() >= 1 << 16) flush();
+        }
+        line += footer;
+        flush();
+    }
+};
+
+static bool parseSize(const char* text, uint64_t& size) {
+    char* end;
+    double value = strtod(text, &end);
+    if (end == text || value <= 0) return false;
+    switch (*end) {
+        case 'k': case 'K': value *= 1024; end++; break;
+        case 'm': case 'M': value *= 1024 * 1024; end++; break;
+        case 'g': case 'G': value *= 1024.0 * 1024 * 1024; end++; break;
+        default: break;
+    }
+    size = (uint64_t)value;
+    return *end == '\0';
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--size N[K|M|G]] [--mix ident|comment|literal|operator|mixed] [--seed N] [-o file]\n", program);
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t size = 1 << 20;
+    uint64_t seed = 42;
+    const Mix* mix = &MIXES[4];
+    const char* output = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--size") == 0 && has_value) {
+            if (!parseSize(argv[++i], size)) {
+                fprintf(stderr, "Bad size: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--mix") == 0 && has_value) {
+            const char* name = argv[++i];
+            mix = nullptr;
+            for (const Mix& candidate : MIXES) {
+                if (strcmp(candidate.name, name) == 0) mix = &candidate;
+            }
+            if (mix == nullptr) {
+                fprintf(stderr, "Unknown mix: %s\n", name);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "-o") == 0 && has_value) {
+            output = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    FILE* out = output ? fopen(output, "wb") : stdout;
+    if (out == nullptr) {
+        perror(output);
+        return 1;
+    }
+    Generator(seed, *mix, out).run(size);
+    if (output) fclose(out);
+    return 0;
+}
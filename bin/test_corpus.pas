@@ -0,0 +1,959 @@
+program Generated;
+
+var
+  counter: integer;
+  total: integer;
+  result: integer;
+  index: integer;
+  value: integer;
+  buffer: integer;
+  offset: integer;
+  limit: integer;
+  temp: integer;
+  flag: integer;
+  done: integer;
+  current_char: integer;
+  message: integer;
+  name: integer;
+  left: integer;
+  right: integer;
+  node: integer;
+  count: integer;
+  sum: integer;
+  average: integer;
+  maximum: integer;
+  minimum: integer;
+  position: integer;
+  length: integer;
+
+begin
+  { and generated token generated of reads generated lexer grows input when when and when of checks nothing that lexer of generated input }
+  if flag = left_935 - (40.5 * maximum mod 25255) then name_498 := temp and 796.35;
+  if 527.2 / buffer div limit * (253.83) >= node then result := total_331 or average or 51217 mod flag;
+  { checks each checks checks reads input checks and this grows when token that nothing reads }
+  name := buffer + offset;
+  total_603 := 'lexer and when program that when token each token';
+  if 295.19 >= 983.25 * ((235.40 div temp) or sum_537 or 510.10) or 58644 / 755.13 then message_25 := (24949 * 666.55 div (31242)) div node * 42714 - 666.50;
+  offset := 'lexer when generated';
+  { when lexer of reads and reads of lexer of of when when and the }
+  total := length_708 + sum + name_325 + counter_663 + index + message;
+  flag := average + count_634 + done + maximum + node + value + length;
+  average_58 := limit + offset + left + node + length + length_140;
+  message := current_char_714 + result + index_580 + node + left_508 + value + maximum;
+  { each checks of grows input grows this reads nothing when token }
+  temp := index + offset_101 + value_580 + offset_315 + right_821 + flag_373;
+  if 24156 = (counter mod (345.48 and 99249) / average div message) then length := 22825 div 19344;
+  maximum_670 := 'grows input the generated program';
+  if 55153 > 795.28 * (value + right_213 and value) then maximum_112 := 35223 mod index * 61345 * (((254.57 mod minimum)) * value and done_165);
+  if (709.32 - offset div (temp - 75139 / average_733)) < ((length and 18242 / total) / (113.56 * sum_103) and 18995 and (counter_788 or name)) + buffer / 288.15 or temp then buffer := (245.78 * (752.64 + 87676 div (634.64 + result_620 * 701.13) - (left)) / (value div average and sum) and 828.13) + 427.58;
+  done := index_479 + maximum;
+  (* each checks the and checks that
+     grows nothing generated breaks grows generated reads the generated token
+     *)
+  { lexer input and lexer lexer this this nothing checks of breaks when token token generated the breaks nothing reads }
+  value := 'each token reads grows grows nothing reads';
+  length := length + buffer_372 + message + minimum_4 + index_458;
+  left := 'grows program generated the that checks reads that program input';
+  (* the each the token that and the nothing grows
+     that each this and
+     this reads and nothing grows program token
+     the the token generated
+     *)
+  if average_178 * ((46504) / count_926 or 941.27 and 464.50) + (463.28 / (66945 and 708.34 / (39922))) div position_883 > ((342.12 and right / 95461) * 387.45 * (temp / 98.12)) + 14519 * 68756 then counter := position_220 and (index + message_515) * (43213) / 127.67;
+  flag := 'token reads each and of token token token lexer';
+  (* reads generated token generated lexer
+     the nothing the checks checks of
+     this that when input and nothing
+     *)
+  if (sum or 708.2 / average_481 and 791.23) div ((buffer_894) * average_95) mod length_94 <= temp then minimum := maximum_8 mod 76253;
+  maximum := position_285 + maximum_207 + limit_896 + temp + length;
+  if current_char > 240.29 then message := 765.31 - (offset_860 / 231.45 / 322.86 mod ((total) / 656.12 or (21860))) + 117.16;
+  position := right_0 + total_9 + average + average + left + minimum + flag_866;
+  value_695 := 'l';
+  position_370 := average_731 + message + counter + count_361 + count;
+  if (((651.30 + 88199)) - left + node_78 / message) div temp / ((value) - (495.26 - (total_498 * 20827 div 82176 + 8.88) or done) or (49891 and 54956 + 393.28 div 892.19) or position_648) > 93227 - position_486 then count_370 := right div result - 843.48 + (74372 * 676.18);
+  done_810 := offset_84 + node_296 + temp_114;
+  (* lexer token reads when input nothing program of that this reads lexer
+     grows program when that that program
+     input that lexer and lexer
+     when input this each nothing checks and this checks grows grows checks
+     this of that of breaks each nothing the when reads
+     this nothing generated generated
+     *)
+  offset := offset_955 + flag + left + done;
+  maximum := length + result_586 + left + position_239 + temp;
+  sum_108 := 'm';
+  { that generated each this that program nothing this this checks and checks of grows when this reads checks token the generated }
+  (* reads input the of input of breaks input each nothing and
+     generated this program of program the
+     reads of input and reads program generated breaks reads lexer token
+     program reads token token this token
+     program checks reads and of
+     *)
+  name_426 := 'lexer program program that each that that reads';
+  if counter_846 * 47030 <= sum then current_char := (435.77 / (done) or 24579) + 488.87 + 73.83;
+  message := 'of lexer when each reads';
+  value_516 := flag_56 + average + right;
+  message := result + minimum_57 + flag + current_char + offset_802 + flag + flag;
+  if total / temp_750 > 43.9 then index_383 := (((44468) / (minimum_794 - left + 182.22 / maximum_410) mod sum) div (counter_421 or 456.2 + index) + average);
+  name := done + sum + result + result + maximum;
+  node := 'q';
+  sum := 'x';
+  if 330.7 + 270.54 / temp <= ((value and 89418 - value_446 or node_571) div 96246) - left mod ((19918 - (484.60 and message - 58144 or average) or sum mod 23621) mod temp) then done_175 := left or left;
+  if (99274 and length mod name and count_82) + buffer = message / (73042 and (596.89) + index_844 mod 59742) / average then done := 65648 + index * (2097) and 758.30;
+  (* breaks the this that each the each each program grows when
+     when reads nothing lexer that checks checks generated that nothing
+     *)
+  if 77756 div 733.62 <> 58992 or temp * sum_153 then left_587 := (count) and 64752 * count div 540.30;
+  if buffer = result div 242.39 then node := 879.82 / 263.23 + 281.6;
+  result := flag + done + minimum_771;
+  if (counter_478) - 51908 > 62351 + ((64623) / 70.43 * average * 2490) then sum_146 := 246.92;
+  node_740 := position + index + temp;
+  temp := left + count + position;
+  { reads of nothing this that lexer this this generated generated checks reads that }
+  (* each the token input the lexer
+     and reads nothing each
+     the program each reads nothing nothing lexer
+     *)
+  node := done + counter;
+  if (562.49 / 400.82 or ((done_994) mod name mod temp_934 - 24714) and current_char) <> 71.8 then offset := ((307.2) / (length / 94116 * 2740)) + minimum;
+  count := 'the breaks breaks and token of when input token';
+  if counter_644 <> offset * ((minimum_855 and (971.64 mod position_140 mod 658.20) + (765.94 div limit / temp / done_991)) + 829.92 mod value_102 or 492.81) then current_char := (359.82 or 4403 and (247.14 or message_467 mod right or length_986) mod 433.70) mod (4447 div 948.49 - length div buffer) * 48239;
+  result := count_562 + result + left + current_char + done + total;
+  (* this the each each lexer and this breaks and
+     *)
+  done_95 := done + count + name + name + length;
+  if 821.17 / limit_988 = 28521 mod 36040 * index_619 then result := 93057;
+  { reads nothing input and nothing each breaks that checks token when reads each the when when token and grows token and of reads }
+  index := index + maximum + done_331 + done + right_724 + counter_311 + message;
+  message := 'b';
+  position_618 := 'input the grows the nothing the breaks the of that';
+  counter := result + index + total + current_char + length;
+  name_791 := average_193 + offset;
+  { input this checks program when }
+  maximum_11 := left_282 + minimum_384 + right;
+  if position_805 div 32583 mod index div ((6737 - 34935) - 55806 div minimum) = count + (count) - 740.97 and value then maximum := average + 24697 / 692.41;
+  if 312.0 > 876.21 mod (result - 550.83) then limit := value_89 * temp;
+  message := flag_173 + result + name + index + limit_396;
+  { this token input input lexer grows nothing the token reads reads lexer of input of checks nothing each nothing token token }
+  if (56272 mod buffer mod 90489) div count_908 <> done mod message - 113.70 div count_849 then flag_133 := (name) * flag * 661.77;
+  minimum := 'breaks the';
+  if temp mod temp and (992.25 and 72611 or name_799 - ((91255) div name_980 / (average_488 div 81816 / 35431) div 799.86)) > average * 75410 div (maximum_299) / left then offset := index_326 div (38129 / 55146 and 73393 div total_612);
+  if 72177 div 98977 <= 790.58 + 807.31 then done_855 := 185.83 - (name div 836.80 div index_55) div 712.38 and 538.78;
+  message := left + minimum + value + right + maximum + index + total;
+  average := sum_847 + left + count;
+  average := 'nothing that input breaks token this input and';
+  { breaks when and each token checks each generated }
+  sum := 'and nothing nothing reads input each each nothing each checks';
+  node := result + sum + length + position_442;
+  value_267 := maximum + index;
+  index := result + name + length + right + length + left + position;
+  { checks token breaks each program generated program program reads token input that input program reads }
+  average := buffer + position + right + length;
+  buffer := 'lexer breaks';
+  message_134 := index_806 + buffer;
+  { checks of that lexer grows of grows and and when of when }
+  total_491 := position + offset + flag + name + message + offset_415 + count;
+  position := limit + limit + result + index + current_char;
+  right := 'checks checks this program';
+  if 21723 - right_944 * (839.75 div (index mod length_860 / (buffer / 433.86) + counter) - 438.40 or 5861) div (limit) >= minimum and 308.60 + (result) / value then position := name * 15338 mod (total_937);
+  if 514.4 <= index / (node + sum) mod (sum_868 * (89100) and sum) * 94.18 then counter_469 := 16792;
+  length_357 := sum_442 + temp + total_893 + length + name + name + right_878;
+  name := 'lexer';
+  right := 'of each token lexer checks and grows generated that';
+  sum := average + count_11 + name + current_char;
+  offset_792 := 't';
+  maximum := 'each that program generated grows token generated input lexer breaks';
+  if 337.74 < 75165 or 23222 / 644.43 mod 96684 then node := temp / 13696;
+  message := offset_672 + name_643 + length + flag_957 + current_char + total_753 + offset;
+  temp := message_158 + average + index_564 + count + buffer;
+  if (position_118 / limit) div 456.15 / (temp div flag) <= 67063 * limit + value - result then name := flag * ((959.7) + done_765) and 75117 * (84841 - 564.92 - node / 572.83);
+  if 76257 div 49.91 mod ((296.63 / 33754 * 255.31) or (flag_777 or offset / limit_236 and left) * (573.46 - sum)) <> length * node_577 then message_7 := (931.29 / (total * 580.24) and 898.49 and result) / 50131 * ((length or result) / ((flag - 440.79) * 85884) + minimum_724 / ((22087 - 56506 div counter_321) * (flag_126 - node_526) + minimum_293 mod flag));
+  if temp >= minimum then minimum := position / ((89965));
+  average := total_860 + index_704 + sum_272;
+  minimum := message + total_513 + temp_932 + node + maximum;
+  position := position + length_56 + length + name_756 + result_142 + value + maximum;
+  if counter <> 68430 or (40908 and current_char div 493.83) then sum_770 := 460.87 or (offset);
+  count := average + value + buffer + left + maximum_900 + minimum_369;
+  (* lexer when when each
+     breaks token program reads breaks token reads
+     *)
+  (* input this each the
+     each nothing nothing token nothing generated lexer checks and program
+     generated the and generated program and the of lexer this
+     each breaks program breaks
+     generated checks reads breaks token program lexer reads input breaks of of
+     *)
+  (* when reads the input program checks the nothing when each and the
+     generated breaks program nothing the of of of that when
+     reads each grows checks lexer lexer token lexer reads grows when
+     input input program nothing checks nothing
+     *)
+  limit := 'k';
+  offset := 'n';
+  (* program grows breaks reads program token of of
+     of this this the breaks lexer checks reads
+     each input this breaks nothing nothing when
+     this lexer when token when each lexer nothing the token
+     *)
+  offset := 'input of grows reads the';
+  (* reads lexer input token when
+     the of token checks
+     reads token token grows
+     *)
+  right := 'each lexer breaks nothing generated each input';
+  (* the token checks and of checks
+     breaks grows reads each reads breaks
+     nothing program checks the
+     nothing this program the of this
+     checks nothing and that each breaks and each
+     lexer the that breaks and nothing the the checks breaks each
+     *)
+  (* input generated nothing lexer program checks input input
+     nothing grows this this token lexer lexer nothing
+     *)
+  if (counter_311 div 86253 mod counter_932 or 5332) < sum - value_211 * (63475 mod 387.77 * 85870) then minimum := (counter_217 - 320.71 and limit + (369.45 / flag)) * buffer_693;
+  if 4321 - 800.44 mod maximum * offset >= current_char_358 or 603.76 then sum_208 := (maximum_875 + 521.67) mod value_176 and 565.29 or 836.44;
+  name := 'z';
+  right := 'grows generated';
+  current_char := index + name;
+  { when program lexer lexer breaks lexer reads reads breaks reads grows token the grows lexer }
+  if 12839 / 44770 + message + 877.26 < count * ((558.48 and counter_922) or 86230 * value or maximum_463) / (value and offset mod current_char) mod maximum_410 then total := 466.5 * node_813 div (offset_158 - count_428 or (count + index));
+  (* breaks grows when when nothing the grows breaks grows breaks the
+     of reads generated generated input this the lexer lexer of reads of
+     that reads grows grows input grows
+     *)
+  { breaks each program generated program generated the program reads reads }
+  counter_72 := limit + current_char_477 + result + flag + message_634;
+  offset := done + value + total_649 + sum_148;
+  name_763 := 'z';
+  average := right_755 + value + counter + value_88 + value + buffer;
+  if count - 21155 <= left_621 or temp and done then message := 41511 div ((99268 * 534.52 div limit) - 903.78);
+  length_258 := buffer + maximum + current_char_849 + sum + value_483 + length + position;
+  { reads nothing the lexer the generated when that lexer nothing input and program program this }
+  name_983 := 'grows token';
+  value := left + index + value_930;
+  (* nothing that token checks this and
+     reads checks reads when program breaks
+     each that and each
+     *)
+  { generated token input generated token each token lexer each of generated the when token breaks }
+  position := average_125 + maximum + average + flag_643 + total_597 + right + limit;
+  if 70191 / (43712 div 338.93 mod counter * message) or 739.11 < 81964 mod minimum_503 then done := 151.46 - ((name - 175.94 and maximum div minimum) + length mod minimum_652 div ((17879 or 627.37 - 699.3)));
+  (* lexer of of program the program program program that that the token
+     *)
+  if minimum or result_376 <= (753.33) - limit * 176.31 div count_910 then limit := 34638 or 217.19;
+  name_749 := 'd';
+  sum := done_493 + done;
+  average_248 := 'a';
+  limit := 'y';
+  limit := left + temp_981 + current_char;
+  temp := total + temp + done + offset_241;
+  current_char_130 := counter_591 + length_383 + minimum + name_995 + name + length;
+  left := node_218 + limit_380;
+  if 48661 < result mod 72.54 then result_110 := ((98675) div right mod node div (94853)) or 75578 div 119.26 / minimum;
+  if 30248 or average - (index_424 / total) < maximum + ((514.75) + result or minimum_696) then right := 49749 / average and length;
+  if 215.28 and (480.90 div (current_char_762 div done and (node / count_852 and maximum - flag_928) * (count_989)) * name) - (237.33 mod sum * limit) * value = (9293 or 906.12 + 727.18 and 570.50) - value then total := (limit) + buffer_876;
+  (* checks each and generated this the this grows each and
+     *)
+  node_264 := name + flag_302 + position + buffer + length_914;
+  sum := index_995 + maximum + counter_251 + done + position_199 + value_472 + current_char;
+  (* and when each that grows that breaks the the token of each
+     this generated input when
+     when breaks nothing when program breaks breaks lexer
+     program generated checks nothing when the reads each each the
+     token that token this input input nothing of
+     *)
+  (* nothing breaks token input and and breaks that token that input that
+     of the token this nothing input
+     of input the that of checks nothing grows input
+     this grows token that each this breaks
+     *)
+  { of each and checks lexer reads this lexer generated generated generated the }
+  if 438.6 + 958.47 and maximum - counter > 818.2 + buffer / current_char then left := 51509 mod length and 96218 + 663.46;
+  name := count + right + temp_387 + node + sum + result + node_439;
+  if current_char or maximum * 265.14 / result >= 12310 mod 196.6 * 50522 then index := 71027;
+  temp := right + offset + left + counter + average_139;
+  value := limit + left + position + right + flag;
+  { that and and program and }
+  if 158.12 * 13805 and 49695 < (left_692 or 177.80 - count) then right := name_109;
+  temp := count + current_char + right + current_char_939;
+  if result_482 / 63633 + (offset) or done <> ((message and (671.11 * result) + done) and 14090) then message_47 := 78661;
+  message_474 := value + value + node_472 + current_char + done;
+  { token lexer grows program this generated input each the when each grows each and breaks input grows lexer checks }
+  flag_69 := node + counter_452 + minimum + buffer + buffer + buffer + offset;
+  if name and (result / 54397 * total) > (53973) mod 72299 then name := current_char_888 * (current_char_972) * buffer_291 + count_900;
+  if value * (index and (result / 595.81 + 58282) + 37866 + sum) and 493.86 * count <= 971.60 - maximum + 68134 then limit_644 := done mod message_797 / right - total;
+  if (name and maximum + ((46643 - counter - message_881 / message_689))) and result_934 <= 903.38 then flag := result div 406.28 + (((62677)) / 23.32 + 418.24) or total;
+  value := 'lexer each of';
+  left := 'and grows grows the';
+  sum := length_479 + right + buffer_900 + right_761 + count_356;
+  if (count mod count * 792.24 and 62331) and (sum mod 30 or counter - ((flag_817 or buffer / flag) mod position - (530.31))) and (27634) - message < (23921 / (65198 and average and 760.27 - node)) div (87042 or flag / result) * message then current_char := 521.19 or average;
+  if position_873 * 10319 and 34602 mod average_214 <> 80515 or 60.12 / 548.61 then node := 33033 mod 866.47 and 40027;
+  temp_624 := 'this generated generated of program this reads that program';
+  { when input grows this token the }
+  done := minimum + minimum;
+  result := counter + flag_506;
+  if count_502 + current_char_789 + 17680 <> 71776 mod right or node then buffer := offset;
+  counter := 'f';
+  (* that checks generated and token nothing
+     program generated input generated breaks
+     *)
+  current_char_866 := 'program this grows';
+  if buffer_267 div ((77189)) mod length <> 952.99 or 21749 then position := minimum - 325.86;
+  { that the reads input nothing that token breaks the of token this each the generated each breaks this program token nothing }
+  result := 'm';
+  if 771.55 = 74676 * (416.43 - (468.35)) then message := 263.54 or 10758 / 1271;
+  if ((position_893) - 464.89) * ((543.60 or left) mod 918.46 div result and (left * 46662 * 391.99 or average)) and temp or 34870 <= left and limit then current_char := maximum;
+  buffer := 'y';
+  if 157.9 < (((done_246 div buffer mod 649.68) or (717.28) * 298.90)) + (total and 250.30) or 323.61 - 30780 then counter := (13740 / name_88) and ((99.24 div temp / 43131)) * limit_128 and 578.9;
+  (* each checks of breaks this
+     and the input token nothing the input
+     nothing the each lexer breaks when each breaks grows
+     *)
+  left := 'generated';
+  value := sum_947 + node + left;
+  (* each input breaks each checks checks the reads
+     this each generated each each the token each each reads
+     this and the when the the
+     checks grows input generated lexer that reads that and reads
+     this token input of and that generated each of of checks
+     *)
+  minimum := temp + limit + average;
+  flag := buffer + maximum_474 + count + message_268 + temp;
+  total := 'e';
+  node := right + flag + offset + offset + sum + buffer_154 + name;
+  buffer := name + message + counter_234 + index;
+  done := message + minimum + node + temp_538;
+  maximum := count + buffer_388 + node + left_628 + count_532 + name_329;
+  result := 'w';
+  if 24951 >= count * 87730 and message then index_936 := (364.41 - name or temp) and flag;
+  if buffer_706 + 36444 <> (offset_536 / 549.87 div 72027) * 46031 and node and count_36 then counter_127 := (temp) mod length - (length - 45787) mod 67879;
+  flag_780 := count + counter + count;
+  { breaks that when reads program that nothing lexer each token input grows that that lexer checks input of each }
+  if limit_467 * left mod 54453 <> 709.97 * 43634 div maximum_344 mod 46661 then name := result;
+  total := offset + name + done;
+  flag := total + position;
+  if (139.35 / 714.38 and 95181 / temp) < (962.74) - 29427 + counter then sum := 73241;
+  if (278.64 and (position_901) and name_239) * 488.11 and (90519 * 58.81) >= 6.72 mod buffer - node then message := 77824;
+  if (sum div 498 div 841.43) * maximum_316 / 50815 / (result) >= (((flag + 556.27) * 18064) * 46134) div average_671 div ((node mod 187.95 mod right) mod 675.43) or (flag_135 / (result_462 mod 98889) - (95950)) then length := 291.47 mod 27879 * (333.18 mod 748.44 mod 444.12) div (25.19 or (88143 mod 94337 - (position)));
+  if 226.93 / length_325 > current_char mod 800.70 + (message_827 or 86850) then limit := name / 23546;
+  count := 'l';
+  { reads checks when grows }
+  if (490.26 / current_char / 29387 div ((430 div sum_925 and 523.70))) = 894.37 - count and limit and 356.52 then temp := 175.33 mod maximum * node_866 mod (average_259);
+  sum_871 := temp + index + message;
+  (* nothing breaks grows each input
+     input that generated and
+     *)
+  if offset_491 - 49495 mod 58130 or (name or (offset_673 / (62505 + sum mod 217.34 * 607.86) and (left_764 / name_759)) * (544.46 mod (944.55 + 603.27 mod count div 48119))) >= 85715 and (368.7 - length_781 and offset - 38.92) + (index_382 or left) then position := length_842 div (name_183 / result_453 mod node + 9386);
+  buffer_610 := 'breaks each this program';
+  if result / 44.1 * (((17.12 mod right_426)) - 287.80 / total) or (done div 38271 mod 549.7) > result and 32035 mod ((513.56 - (buffer_635 / temp or 66424 or flag)) * count + 771.75 * name) div (node) then name := (40.20) * maximum / maximum * (645.64 and 843.95 or 42962);
+  (* generated breaks token lexer lexer
+     and nothing of this lexer this lexer token input when checks
+     that generated each grows breaks that token program
+     *)
+  if name <= (message / 525.91) then name_913 := sum + 554.99 - (286.93 mod minimum_911 and average_645 mod (574.83)) mod 44827;
+  maximum := 'token that program and each grows token the program';
+  current_char_322 := node_879 + node;
+  { grows token reads reads reads and each checks each generated breaks lexer and checks grows that }
+  temp_423 := 'r';
+  if ((count_783 * result_425) - node mod buffer div 222.46) or value - 944.26 <= (93939 mod 674.69 - 7971) * 22262 then message := 13393 and (count mod 48517 + 723.31 and ((length - offset))) + 36312 * buffer;
+  if 328.44 / (210.13 - 53471 * result) = (1.62 - (limit)) / buffer div (83235 / 57203 / 974.79 - 623.44) * name then count := left;
+  message_179 := 'checks grows input the when program breaks nothing lexer nothing';
+  count := count_156 + message + message_102 + left;
+  { this of reads generated and program the checks }
+  message := 'm';
+  done := 'p';
+  value_679 := sum + buffer + result_370 + flag + temp_674 + counter;
+  if 71164 < message then current_char_873 := 146.65 * 24027 / index_780 mod 355.96;
+  if sum_415 or (done_825) + result_940 > 272.71 or (right and 402.93) then position_745 := sum_424 or 499.71 and (836.27);
+  (* of when grows input the generated
+     breaks the generated of this input
+     the breaks lexer nothing of this
+     checks the generated and each the grows checks
+     *)
+  if (795.48 and average - 51399 - done) and 470.25 <> minimum then maximum := (value_244 mod 804.62 or 793.51 div (temp_949 or position mod 96082));
+  current_char := 'when';
+  if 84817 and 1214 > 863.25 then message_923 := 36595;
+  if current_char <= done then offset := index_679;
+  limit := average + total + buffer + result;
+  right := left + done_619 + maximum_437 + name + temp + limit + sum_78;
+  if 35465 > ((offset) mod 535.65 div result_64) + message_481 * 260.30 and 11117 then done_590 := 997.56 - 201.35 * (713.64 / 38752 - length + done_107) or minimum_304;
+  { lexer breaks each token program nothing of generated }
+  length := 'u';
+  if (63511) / 704.50 + 24672 < count_108 then sum := ((length + 76272 + (349.23 mod 822.71 and 37.7 mod maximum)) * 576.35 mod (24298 * 792.44));
+  { when breaks and the reads that this breaks checks nothing program lexer generated }
+  done_588 := 'program reads generated';
+  offset := average + length_123 + name_174 + counter + flag_888;
+  maximum := 'checks of reads breaks input the';
+  offset := current_char + position_18 + left;
+  maximum := limit_554 + counter_5 + average + buffer;
+  count_810 := node + current_char_940 + done + count_779 + position_62 + node;
+  minimum_693 := result + length + counter_458 + position_948 + limit_711 + total_394 + right_963;
+  total_572 := message + minimum + value + index;
+  buffer_430 := 'of token grows nothing token checks nothing';
+  limit_391 := right + value + counter;
+  if limit_850 and ((886.35 mod (25727 / 975.82 / position div minimum_317) * name)) * (temp_107 - 150.5 mod 79653 or (length_747 / position_553)) > (limit_746 * 105.65 or buffer and left) / 87.74 mod buffer then message_960 := maximum_686;
+  limit := done + done_566 + temp_392 + limit_500 + name + counter_52 + result_801;
+  temp := 'token of token this checks breaks input nothing the';
+  offset := 'program grows that';
+  flag := 'when';
+  message_219 := 'grows when input token each grows token';
+  current_char_261 := 'checks grows nothing checks when generated token grows';
+  if 171.72 < right and result or right mod 588.43 then left_602 := name or (16915 or 119.15 div offset or 66043) and count - total;
+  average_643 := 'j';
+  result := node + message + current_char + done + limit + index + length;
+  if total div counter_127 mod (temp - limit * result + (147.33 mod (873.15) - 346.18 * (41009 or temp + count mod name))) <= current_char then temp := counter + 45906 and node_272;
+  current_char := node + index + counter;
+  counter := result + temp + current_char_581;
+  { nothing generated when breaks input of and program program nothing when each generated of program reads }
+  count_738 := 'generated grows';
+  message := count + maximum_694;
+  if flag - 22.81 + node = 955.57 + (result - 864.0 or 46870) mod offset_628 then flag := limit div offset or 49802;
+  temp := 'checks checks this and checks checks the';
+  name := 'grows breaks when checks the breaks nothing generated';
+  flag_384 := value + right;
+  if 95588 or 99534 / 48639 / (42213 - 782.67 / value_662 / maximum_774) > 31.95 and ((26516)) then length_386 := (929.11 or 27291 div ((281.68) or (901.7 mod message) * 22605) * total_828);
+  { and grows this breaks that nothing program generated program this grows checks }
+  count := 'that when checks';
+  { breaks each that the checks program program grows reads program reads }
+  length := flag + current_char + left_751 + average;
+  right_1 := 'generated grows the the program grows';
+  if 4405 or (length_591 div (21467 or value) or 371.65 - 95.55) / 591.4 < message / minimum then right_214 := average - message or offset_934;
+  { lexer reads grows program token lexer reads each each each checks and of generated token }
+  if 933 <= 13956 - 84265 - 53286 - 19127 then value := 74.32 * (done) div (378.91 + limit_487 div ((962.15 and done_283)) - 657.72) / (limit - 18806);
+  if current_char_785 > 14.2 div 33894 * limit_704 or flag_570 then result_669 := 45157 and right div ((buffer) and message_302 div length / average_687) div 445.51;
+  if 361.33 > (614.39 and done) and (72902 * 30202 and 884.41) * temp then position_224 := 14217 mod (average) / 980.93;
+  count := 'this and the breaks reads reads';
+  if ((38834) / message and 26310) * 77.75 div current_char * 650.20 < counter_756 then flag := ((223.47) / length div 995.1 div 425.0) + counter;
+  flag_749 := total + total + maximum;
+  (* when generated generated input when grows and of
+     nothing this generated breaks generated the lexer lexer breaks that this
+     grows input grows input breaks breaks breaks
+     lexer reads nothing of the each generated lexer nothing
+     *)
+  (* grows that reads grows of program checks lexer
+     token generated when grows the grows grows token grows input nothing
+     the of checks that token when
+     the this of generated that input
+     input grows checks breaks generated generated that and checks
+     *)
+  right := 'y';
+  length := done_450 + index + offset;
+  temp_16 := 'nothing and the program the program lexer checks nothing';
+  if left div (name / result or 36963 / done) - 24734 <= 13859 then maximum_569 := 95248 + 513.62 / minimum div (total_741 - 79657 div node);
+  sum_875 := sum_346 + message;
+  { input of nothing and lexer this when lexer lexer generated lexer this generated generated checks checks and }
+  right_963 := 'and reads breaks that nothing this';
+  if left_527 >= 16031 - name then sum := 992.32 / value_651 or 92200 and (70452 or index mod 695.65 - message_853);
+  { that that the of breaks program breaks this checks of reads the that each input that input lexer of grows this }
+  if message_413 - 30389 and 59.35 < (465.45) then current_char_989 := ((average_331 / 16140) and (362.58 + 123.51 - node) mod total * 93421) * maximum_166;
+  average := done + position;
+  if counter_684 mod ((index or message / count_263) * current_char) / 929.9 - (866.90) > (done - 63393 - (74.40) or (98612 or 612.83)) and 973.49 + minimum then total_138 := position_164 and (done mod (9413 div (719.33 - 570.40 div left_479) and 610.44 and length)) * ((flag_405 mod 72.57) and name * 229.10) mod sum;
+  position := 'c';
+  if 808.37 and 92002 = (maximum / message mod 10418) then position := position - 386.17 or 35787;
+  if offset / count mod (((534.43 or buffer_263 mod 36913 / 163.46) * 774.85) - value_512) > value + result and counter + (temp_851 and 553.10 or (temp_361 * limit / minimum - 267.11) div 958.52) then current_char_345 := done;
+  right := offset + right + flag;
+  { program that lexer lexer this token of nothing checks checks breaks lexer token and the when of this program the generated that generated }
+  limit := 'generated lexer';
+  node := average + count + limit_330 + index + count + right_190 + offset_891;
+  node := 'the lexer checks';
+  left := length + buffer + total_453 + temp + offset + total;
+  if ((89.79 * 84911 - (node * offset_850 + offset - limit_726)) and 592.4 + (limit / limit_399) or ((55175 div 9924))) div index_648 mod 28242 mod right_190 >= 107.81 + 92594 / (((sum_752 - 89594 div maximum_43 or position) mod 668.23 or 99392) / (limit or left * offset_710) - 950.55 mod 36306) then minimum_534 := ((minimum_754 mod average_832) or counter_736) and 973.37 div left;
+  { checks the program when and nothing of generated reads grows the token breaks each nothing reads the input each when generated checks }
+  { grows grows when reads when breaks input nothing that checks and input input and of reads }
+  current_char := current_char + name_755;
+  counter_966 := buffer + buffer;
+  maximum_741 := index + maximum_887 + node + flag;
+  total_971 := 'lexer the reads reads program each the token input';
+  value := count_63 + sum + done_81;
+  offset_643 := done_8 + counter + sum + total_871 + offset_359 + count + left;
+  temp := 'the token when';
+  (* each checks token grows the when the lexer
+     lexer nothing each checks
+     checks this and token the program when lexer
+     checks program token grows input breaks generated
+     *)
+  (* reads generated grows breaks and the program grows reads the nothing
+     *)
+  name := index + node_815 + message_620;
+  maximum := sum + length + count_200 + total + average_82 + temp;
+  result := message + current_char_419;
+  (* that the input checks this that grows and program
+     of and checks generated generated nothing
+     breaks generated and lexer this program
+     each each breaks breaks input
+     *)
+  sum_398 := 'that and input';
+  average := 'checks nothing of';
+  temp_746 := left + position_451;
+  if 225.14 or 42449 <= ((11715 / 655.37)) - 93253 mod 356.71 or (minimum and limit_663) then name := (count_617 * 626.54 * right) + flag + 913.61;
+  result := index + index_512 + name;
+  (* input token token checks token breaks that each each input
+     checks the reads of lexer generated reads
+     program program breaks breaks that
+     and nothing that each each generated grows lexer grows generated lexer token
+     breaks grows input token this grows lexer input each lexer
+     *)
+  if buffer + sum_928 <= (minimum * position_616 / (55438 - value) div index_288) then left_155 := total or 958.20 / total;
+  if (49125 div 693.72 / 590.83) < ((39465 + (545.1 * 924.7 div 757.41 and right) or (108.64)) and minimum) - flag * minimum mod limit then index := (99518);
+  flag := maximum_293 + offset + sum + counter_857 + count_161 + buffer + value;
+  (* each of generated nothing and this that this lexer reads lexer
+     this and token checks generated checks
+     program lexer of program program each lexer checks and input
+     *)
+  if 30011 >= (41777) div 86308 then name_166 := ((56959 and minimum) and right_270 mod ((703.20 / index_361) / (node) * (flag - 39555 - temp mod position) mod (buffer / name)) mod length_372);
+  if done * 78724 * (total_509) <> (length_574) div ((18665) - (927.1) div counter / 24364) mod minimum_24 then flag := name / length;
+  position_486 := name + value + name + minimum + average + index + index;
+  done := left + current_char + offset + buffer + limit_569;
+  offset := average + name + sum + limit + left + index;
+  if 95709 + (54727 + (26812 - (81264 * 50367 mod done_448 + 393.31)) - 12542 * (current_char_772 mod minimum)) = ((18748 * 447.34) / buffer_871) or (421.88 and right or 532.30) then total_635 := (((825.5 and 44961 or 93178 - 340.2))) + length and (done_799);
+  position := sum + result + maximum_864;
+  { program reads checks each when token that checks this the }
+  left := position + length_739 + offset + count_265 + position + current_char;
+  (* generated each nothing token lexer nothing this input lexer that
+     of checks of and program reads this the
+     each nothing program when token nothing grows generated
+     *)
+  if index div offset * left mod right_391 = (((message mod counter) - 7063 / message_697 / 134.7) and (right mod 19220 + current_char + (message * 8552 * 15652)) - (50668) * message_580) div 64277 * message_422 div (60104 mod 988.51 / (current_char or 36096)) then minimum := (buffer * offset * (sum or name - 795.40)) / position and flag;
+  if 647.45 > message then total := node * ((87137) + left_148 and temp) or 702.84;
+  minimum_247 := total_605 + length + limit + current_char_521 + minimum_628;
+  if ((79631 * 85642 + 786.37 / result) + count_134) * counter > 976.97 then limit := ((463.90 or 914.28 * 24907 and done_126) + index) * (7515) + (count or 953.69 / result div 93881);
+  if 66103 or count_846 = (9121 - counter mod 492.99 and 17841) and 549.89 then counter := maximum;
+  if (59235 + 37726) * node_233 >= (93.24 * done + 71786 + 274.51) / (66377 mod 19181 mod (69781 * buffer_491) + sum_748) then index := buffer;
+  { the program lexer grows this lexer that each nothing checks the program the this lexer lexer each of checks nothing token }
+  maximum_870 := sum_444 + value + sum + position + done + result + value_42;
+  done_234 := 'checks';
+  done := index + left;
+  buffer := 's';
+  if (70507) - 15855 <= 564.81 or (13800 mod ((95835 / 44874 mod 186.71) or (current_char_201 or total))) then buffer := right;
+  average := 'token program program program nothing of checks';
+  total := sum + count;
+  total := count + node + position_571 + position + done;
+  buffer_561 := 'checks nothing lexer input when nothing nothing';
+  if ((71334 or (counter mod offset_828)) mod 799.4) <> (188 or (flag * flag_128 mod count_527)) + 790.73 then buffer := count_188;
+  if 402.76 mod maximum <= 648.44 - offset - node + 5935 then temp := done_579;
+  offset_928 := total + count + maximum + temp + offset + value;
+  (* token the grows checks lexer that lexer grows that each the each
+     nothing nothing token and
+     breaks lexer breaks breaks the
+     *)
+  if 825.7 or 118.66 + 344.77 <= sum_12 / 54581 then counter := (result div (average_614 div 96858 + (496.31 mod offset_858 - position_133 - node) or (823.50))) / 110.51;
+  flag := 'j';
+  maximum_727 := result + name_694;
+  { of each each lexer generated checks when this input when each input that each lexer grows when }
+  position := 'and input';
+  sum := 'that reads checks each each token generated checks reads';
+  message := done + done_140;
+  flag := index + result;
+  message_46 := position + sum + limit_156 + left_792 + counter + value + flag;
+  temp := offset + done + right + right + counter_449 + buffer;
+  buffer := average + limit_392;
+  message := 'i';
+  name := 'j';
+  (* token breaks grows the breaks this token generated when input reads that
+     *)
+  average := 'that that reads generated grows checks';
+  node := count + length + total + counter_856 + sum + done;
+  value := average + offset + maximum_18;
+  total_440 := left + flag_708 + counter;
+  if (714.21 and minimum and 44059) - 20.90 * 73.98 * 269.39 >= 494.80 - ((188.55 and result_635)) then position := 8119 div maximum;
+  if 95302 = ((210.98 div result - (523.11 / 12547)) * right) then node_49 := temp_601 / limit;
+  sum_44 := position + limit;
+  if count > left_442 then counter := current_char and (80849 or 291.81);
+  counter := current_char_82 + buffer_550;
+  offset := limit + maximum_466 + right_676 + position + sum_308 + index + limit;
+  offset := 'lexer';
+  buffer_858 := counter + right_120 + message_426 + node_80 + current_char_371 + value_260 + name_220;
+  total_768 := result_25 + flag + right_34 + index + done + result;
+  if 47984 mod (81.69 - offset) > 31375 mod (11.62) + 82072 - maximum then name := length_392;
+  current_char := 'generated checks';
+  if offset_957 / node_614 >= 84307 then done := (72532 and value + length or 78058) or (message mod 274.34 / result or message_922) or 5151;
+  current_char := temp_244 + position + maximum + offset + node;
+  buffer := 'grows grows and input that';
+  position := right + buffer + right;
+  (* when grows checks checks generated
+     *)
+  (* token breaks lexer token input checks
+     *)
+  if (246.69 mod buffer_59 div 188.88 or 61202) * limit_193 div 90803 > name_259 or result then sum_718 := (1241 * temp) div 904.69 - 891.14;
+  if maximum and average_316 <= minimum mod 195.84 * 282.23 then name := 898.44 / temp;
+  right_993 := total + done + name + name_631 + left_156 + position;
+  { program when of input that each }
+  if minimum / current_char - message <> position - 33070 then name := done and node / 36493 / count;
+  { nothing each grows program that the this lexer of and nothing the input program input generated this the when generated nothing program grows }
+  if 482.83 mod (((476.97) + (value mod 94051 and sum mod message) or (done div 313.10)) + minimum) - 32407 mod counter < maximum_107 mod flag_830 / 32384 + count then index := (position mod maximum and maximum);
+  if ((203.2)) <> 393.24 and current_char then average := ((flag_222) - (value_896 or (34297 div sum - value) div 17267) div 21.30) - 264.42 / 814.2;
+  right_995 := node_740 + average_616 + right_830 + buffer + flag_978 + flag_385;
+  flag_75 := limit + result + count_457;
+  if flag mod 80074 div 47691 or value < sum then length := buffer or (74320 div 560.81);
+  length := 'reads lexer program nothing';
+  if 18848 * 496.20 > (62937) and 6373 / counter then limit_800 := (771.95 - 88256 - total_373) / position * (minimum or 11.49) + 959.91;
+  if flag_510 - (551.67 or average) or (613.67) <> counter_622 - (88791 - 326.57 or current_char and temp_320) + (792.20 or value * 972.1 mod index) then name := 840.51;
+  flag := 'of when generated checks generated program of and when';
+  if flag_357 / limit and message div 396.9 > (count_729 + 735.90) - position + limit then length := done_792 + 8019 - 98757 - temp_147;
+  sum := temp_303 + total + counter_37 + value;
+  current_char_452 := flag + index_91 + flag_754 + counter + temp + maximum + flag_926;
+  if average * 4239 and (position_51 - 718.2) / left < 99100 - right * 417.23 then value := (49533 or 99344) * 724.6;
+  { reads checks when of lexer input }
+  buffer := average_758 + sum_912;
+  length_386 := current_char + name + offset + temp;
+  { program breaks of this breaks reads breaks grows the generated this generated that when token and generated nothing breaks breaks }
+  if current_char - 73210 and (current_char or node_674 - length * 63292) / count <> 87744 - length_532 - node / 56.45 then counter := result - offset_789;
+  if value_95 * (limit + index * 85.59) <= 204.50 then index := left or 824.94 / (4640 + index) * ((56439 / 91779 - count * 14702) mod message_394 div 39228);
+  if (930.70 + (14.42)) or (26841 mod result - 79326) and limit_309 mod temp_730 <= 48490 then minimum := temp;
+  if (67969 div 135.51 div node * 79014) < 338.43 then result := 97429 + (length and 12631);
+  sum_354 := 'generated grows grows';
+  if value / offset_727 and (895.5 + ((minimum_567 div current_char) div length) / 11710) div flag < sum_512 / minimum or (temp_257 mod (697.61) div position + position_871) then left := counter;
+  total := 'b';
+  value_597 := buffer + current_char + offset + maximum + total + limit_108;
+  total := message + sum + value + average + temp + buffer + name;
+  { grows nothing each of this grows each reads of }
+  result := 'a';
+  minimum_892 := 'k';
+  value := length + minimum_577 + minimum;
+  if counter_965 and 11679 and 93621 <= position mod done or flag * 386.94 then average := length_848 or ((length or position - index_332) / 325.59);
+  (* breaks each program of grows input lexer nothing
+     *)
+  index_244 := average + message + average_538 + minimum + flag + current_char;
+  if (done_38 / value_793 + right_363 + total_38) * 491.41 <> name then message_8 := 87.84 div (current_char_387 or 82519);
+  message := 'generated reads program breaks generated of generated the';
+  position := 'program token';
+  offset := name_266 + index + count;
+  (* token token grows that this when generated and reads nothing
+     *)
+  message := count + count + sum + index + limit_134;
+  { this this this generated this this checks each checks of this of lexer the program of when checks program nothing of generated }
+  node_634 := 'i';
+  { generated and lexer generated nothing when that reads of this nothing program and token this }
+  name := name + maximum + left + count;
+  if 4149 + result mod total_453 >= buffer * 655.30 div (name_315) / (sum_795 * minimum / temp mod 576.50) then right_19 := temp_166 or value_123 * count_107;
+  counter_942 := index + length + right_230 + maximum + length;
+  maximum_200 := flag + buffer + total + node + counter + flag_180;
+  sum := 'of grows input program grows program and checks reads';
+  if 103.60 / result_709 = ((position - (78885) and (43.94 * 467.90 + left + minimum) mod 350.29) * 825.28 * ((98512 mod limit_665 * right - 46816) - 293.14 * node_448 * done) - value) div 9104 then sum_297 := (node / index and total_696 - 79290) div 94413;
+  if length_551 and temp div minimum_259 * 641.57 > 86978 / 971.10 * 13431 then maximum_530 := buffer_129;
+  if 792.97 >= 989.39 and value_807 then node := counter - value_715 / 68.79;
+  if ((left * limit - 597.86 - (current_char_10 or average_667)) div ((41658 div 167.10) and (done_679 mod temp mod maximum_385 and counter)) * 20385) or (message + name_456) = (flag or 91290) * total then node_761 := average_131 / temp / offset / 845.5;
+  if 71684 <> temp + 835.42 then left := 959.89 and 48478 and current_char_972 and position_649;
+  if 945.63 div (60897 or (33045) + 469.37) / maximum_175 = (node + done_294) then average_91 := flag or sum + (right / index) / ((buffer mod 48025 + 22527 / 583.54) div sum_667);
+  count := index + total_238 + count;
+  message := done + result_456 + name + average + node;
+  if current_char div flag_611 = 819.62 - offset / length mod 29.38 then node := 61238 mod (value div (message)) - message + value_859;
+  if name mod (maximum + sum_353 - 863.13) > 476.24 * length_840 then temp := 87144 + 47063 and length div (((85405 div minimum_874) or 74462) and offset);
+  (* that each the token the and
+     generated of each lexer each this program reads
+     the and each program that
+     grows input the grows when reads nothing that program and token generated
+     this breaks grows breaks that token that this
+     reads each breaks nothing reads nothing grows that and when
+     *)
+  sum := result + length + buffer_950 + value + average + limit + done;
+  buffer := 'of token reads this';
+  { of nothing lexer }
+  current_char := temp_828 + sum_256 + value + result_879 + limit_649 + minimum;
+  offset := 'y';
+  (* reads each reads and this generated breaks breaks
+     input lexer program breaks that this breaks grows and reads grows when
+     generated when input this
+     each grows that token
+     *)
+  average_802 := 'd';
+  maximum := 'program lexer';
+  limit := 'this each this the this lexer each this of';
+  (* of input nothing of of grows
+     the token of reads reads
+     reads breaks and this breaks breaks lexer and each breaks this breaks
+     grows checks when grows this program and generated checks this of
+     *)
+  limit := 'nothing token grows and this each nothing';
+  (* nothing reads program when the token reads that
+     breaks program this and
+     nothing input the input that that that
+     lexer each and reads the reads lexer and
+     token checks program each
+     token each input token this when breaks checks grows
+     *)
+  index := 'reads grows reads reads input checks checks this of';
+  if node mod current_char_899 or (left_962 div node_76 mod (buffer * 240.95 and result)) mod offset_859 > (73640) or 42804 or (625.51 * (908.88)) / (total * flag * (position and 197.70 and sum + (maximum_581 mod 15747 - message_693 div 244.42)) div length_891) then limit := (41050 or result_2) mod 349.73 + (615.89 / 764.2 + name - name);
+  (* generated generated of that generated each input input nothing reads and
+     of grows that nothing reads and program
+     reads this token checks breaks checks this
+     *)
+  position_288 := maximum + left;
+  maximum_771 := 'f';
+  if 456.0 / total - 798.22 = (result / 505.13) and ((offset_986 div (counter) + minimum div (92405 and 5059)) and average_176 or flag_191) mod 266.77 div 25884 then limit_514 := (876.43 mod temp_444) and maximum;
+  (* that reads input and breaks breaks nothing
+     breaks checks generated each and
+     nothing input nothing reads nothing lexer generated of this grows token
+     checks program input grows lexer this
+     *)
+  value := offset + counter_659;
+  left := node + length_44 + left + position;
+  maximum_167 := limit + count + offset + node + counter + minimum_83 + counter;
+  value := index_149 + count_805;
+  done := total + average_229 + node + position + index;
+  if total_332 / 46432 <> buffer_262 mod (temp_855 or 9285 + 902.15) then minimum := (buffer * buffer) div 7303 or (index);
+  right_340 := offset_714 + value + sum_395 + count + offset_426 + average;
+  total := 'y';
+  { reads generated when nothing nothing that nothing lexer this input program grows }
+  if done * ((name or 32596) - 381.2 or (total div limit + (minimum_33)) * (current_char_480 div (3066 + 50855))) / 28523 mod node >= 981.48 then total := 59849 + position + 89142 - 64865;
+  if value_356 and sum <= (offset_579 - count) - right then right := current_char div 208.94;
+  { grows nothing program input }
+  if count_357 mod node div buffer - 330.28 > sum or counter then message_222 := (63006 + (77404));
+  index := flag_370 + buffer + temp_719 + done + value;
+  flag_179 := 'token lexer breaks the';
+  minimum_598 := left + offset;
+  (* this when each lexer reads grows
+     that of program the that each when reads this checks
+     the input generated each reads that
+     that token reads checks each breaks lexer
+     *)
+  if 874.74 or 22055 >= 5.83 then done_302 := (657.99 - 90253) mod current_char div (75188 mod (name div (limit)) div length_933) and 367.5;
+  left := value + total + node + left + temp + limit;
+  node := offset + count_758 + offset;
+  if (4991 mod 487.68 div right_245 mod flag) * 52743 or index_602 >= current_char_415 then offset := right;
+  position := count + buffer + counter + sum + result + length + name;
+  message := 'nothing token input this generated checks nothing';
+  minimum := limit + position;
+  (* each breaks and the generated breaks program reads this the each
+     that this input input
+     checks checks nothing program reads that nothing and reads the each input
+     program lexer breaks that lexer checks the grows token lexer that
+     that reads generated breaks generated that reads token lexer input input and
+     *)
+  result := 'and lexer checks generated grows nothing grows nothing';
+  { the that this reads breaks when nothing token lexer of reads token }
+  if 480.15 + message and (done and 477.98) <= 6.42 then counter := 840.77 / 221.37 mod 759.35;
+  offset := 'd';
+  result := position + count_819 + average;
+  sum_64 := 'u';
+  result := message_326 + count + message_299 + minimum + done;
+  if 748.27 mod (((average / result - right) or average / (19818 * message)) mod temp div 511.84 / (8426 or 79370)) div 95398 <> temp div (92372 div buffer or name) mod 298.57 then counter_788 := 12083 - index;
+  name := 'that this grows token the';
+  done_98 := 'of that that each reads grows nothing the checks';
+  temp_899 := minimum_347 + name_660 + minimum + buffer + limit;
+  flag := current_char + count;
+  sum_99 := 'i';
+  if average < (sum / 189.3 + (limit) / 618.18) - 51198 then count := 616.26 * ((node * 92152 + position_401) - buffer div limit_897 * (9519 / 334.40 * minimum));
+  if (22905 - (87453 and (205.31 mod 57808 mod minimum / 53430) + offset_279) / 531.47) mod total mod done >= 31.2 then current_char := 801.66;
+  count := 'reads';
+  count := 'and that';
+  { this program reads this the reads when this }
+  { program reads program }
+  if sum <> 369.32 * (maximum and sum) then value := 808.82 or (sum div 914.61 + 81.20) - length - length_564;
+  done_212 := value + minimum + flag + total;
+  if offset_885 div 983.92 / message_361 or 90336 > average * (998.27 * temp_946 and (flag)) then result := 80906;
+  if index * (value / right_21 div 79960) div maximum <> message or 781.23 then total := flag or 94536 * 406.64;
+  index := 'reads reads lexer this checks breaks breaks the';
+  (* token checks breaks nothing program reads the checks this breaks nothing
+     generated reads and reads and of that and lexer
+     nothing lexer program each the
+     each input the program grows input the breaks breaks
+     *)
+  minimum := 'token input and lexer of and each of each';
+  { reads and breaks breaks of that }
+  { the the that of of generated breaks and that breaks generated breaks the grows nothing grows program nothing generated lexer and of }
+  (* and nothing lexer breaks lexer input each input each checks checks
+     that the token checks checks reads input
+     *)
+  temp := 'lexer token nothing token of checks generated';
+  if (value) * name + (248.70) <= done - ((flag mod (15236) and name)) then average_639 := average_43 * 817.7 or message;
+  flag_823 := limit + result + length_304 + temp_384 + node_668 + left + count;
+  { reads checks program generated and this when the reads token reads grows }
+  done := 'e';
+  if temp_814 or average and name - buffer_738 <= 355.3 or (index or 72811) or 357.34 * 816.19 then counter_978 := limit;
+  temp_756 := 'the generated breaks and breaks lexer when this input';
+  temp := temp + result + counter + offset + average + average + current_char;
+  flag := sum + message;
+  (* this when of breaks checks generated generated this reads checks
+     reads each that and grows the checks generated
+     *)
+  average_618 := limit_593 + position + name + position_464 + result + name;
+  result_389 := name_812 + current_char + result + name_819 + message_639 + done + result;
+  if (((885.32) div value) and (29212 - minimum - (message) * (169.96)) * position) >= ((41338 or count - temp * (16424 and 13.20 * flag_593)) + 73136 and ((34217) or left + 3991 - 338.4)) * flag + (5671 * ((854.6 * left) - current_char div 852.42 div 7930)) and done then message_371 := index_630 * counter_641 + temp mod total;
+  current_char := length + offset + left + done + result + limit_577;
+  total_75 := 'r';
+  buffer_186 := 'that this lexer that input and token each input nothing';
+  limit := flag + count_978 + temp_939 + message;
+  left := count + node;
+  if value + average < 587.67 and offset / (53456 mod current_char) then length := limit / right;
+  flag_228 := 'that program';
+  (* of when nothing input grows checks this grows each input program and
+     the input input each
+     program breaks each nothing reads this reads program and and
+     of this lexer the the the input the grows reads
+     *)
+  if current_char or flag_170 <> 96781 * 8204 * minimum then position := 333.31;
+  if value_372 + (done * 659.41 - 254.30 or 93913) = total / (((average or left mod node) - (minimum) + sum_233) + 2969 * 105.53 div right_958) and counter_77 then length_676 := total mod 357.33;
+  if node + 280.25 <= 242.39 or 84.69 / 592.7 * index_200 then length_145 := limit div message div minimum mod (358.40);
+  name := 'r';
+  (* lexer token program nothing of lexer grows
+     *)
+  temp_422 := count + count + count + counter + done_519 + counter + average;
+  { reads input breaks the reads lexer lexer when lexer when generated breaks breaks the lexer generated when lexer token and }
+  limit_677 := current_char + average_312 + position_738;
+  temp_677 := value + result_9 + node_223 + index + maximum;
+  position := 'n';
+  maximum_511 := total_805 + offset;
+  flag_824 := 'g';
+  right := 'h';
+  sum_184 := minimum_885 + result + minimum_587 + count_569 + done;
+  position := 'grows of checks of this each each token reads';
+  limit_253 := 'p';
+  { each lexer input nothing this grows }
+  { and checks program the each checks token lexer }
+  name_247 := limit + value + offset + length;
+  index_392 := 'of reads this grows reads';
+  total := 'l';
+  if 71497 - (((66630 / 49088 and position - 445.62) div done_924) / (flag_76 / 50912 * 524.27) / 75319) >= 946.62 + 463.73 mod 71544 - message then right_472 := counter_945 * ((77618)) + result;
+  value := sum + left_346 + average_270 + message + index;
+  (* grows program grows this that that lexer the
+     nothing nothing when each lexer when and lexer the when and
+     reads grows of and that checks grows checks token
+     nothing that token the program lexer
+     when this that program generated input of the that each reads grows
+     that program and lexer the token checks checks the this grows program
+     *)
+  { that when this token nothing generated and of reads breaks when the checks nothing reads breaks program }
+  if (363.34 div flag_758) div flag < left_477 mod 94876 - counter_939 - index then right := name and total_116 - buffer;
+  if counter * (((33120 div right_146 or total) + node_886 - 22130 and 75219) - 92215) <> 915.50 mod 137.35 / 70441 and 917.25 then counter := ((656.24 / (7156 and 421.12) mod buffer_337) mod (node div count_955 div (flag div offset_876 / 637.35 or offset)) mod (current_char / average)) * (56848) - ((25834 / name and (244.24 and 56394)) div ((22926 mod 41183 or 45925 and 72335) / total_728 and minimum));
+  buffer := right + node + done + length + offset + offset;
+  if maximum_263 - (673.67 and 21332 - 947.96) < 21729 and 769.83 and ((890 / (done_914 / 960.90 + done_748 and flag_426))) then count := 31.92 - total * (913.99 * 72658);
+  average := 'that input program nothing grows input nothing nothing';
+  buffer := limit + length + name_80 + limit + result + index_364 + message_452;
+  (* program checks and this grows generated
+     program that that generated of and reads generated token input this program
+     *)
+  sum_103 := value + message_611 + average_57 + position + buffer + index;
+  if maximum + (((74776 or 119.99 mod sum) - 22123 mod 464.17) / (node_780 mod 81232) - left) = index then offset := result_571;
+  maximum := done + node_851;
+  { program lexer each nothing lexer of each checks token program token that program when token reads nothing and nothing and the checks breaks generated }
+  minimum := current_char + index + maximum_86 + flag + maximum_74 + sum_22;
+  total := limit + buffer + limit + right + done;
+  minimum := count_200 + minimum + current_char_731 + node_940 + flag + right + done;
+  total := flag + index + length_62 + done + message;
+  counter := average_13 + minimum_474 + current_char + right + index + done;
+  if sum < 413.98 * node_350 mod (current_char - 65962) div average_770 then left := 26687;
+  if ((72220 div 63505 and (21014) + 55652) + name + limit_810 + node) mod message and 394.23 and 28243 = (663.9 / 70617 div 449.28 * (742.21 + result div left_542 / (362.36 + counter + 20.37 * 113.2))) and (right) - (name_59 - flag or (656.30 + 8453 div (position) / (left_277))) then total := limit / (549.38) - value_645;
+  length := 'i';
+  (* program breaks that each that token grows lexer checks program when and
+     and this token nothing
+     *)
+  average_227 := 'd';
+  if minimum * 870.78 mod 33300 <> 610.45 - 39137 / buffer then average_692 := 667.42 + 57637;
+  message := message + maximum + node_877 + flag + message + count;
+  (* the when reads token generated each token token
+     nothing each input nothing reads program generated generated
+     that nothing reads program
+     checks grows checks generated program reads grows breaks and nothing reads
+     *)
+  minimum := 'of and token token and generated';
+  maximum := 'reads the nothing program lexer';
+  minimum := node + limit_888 + offset_858 + value_905 + length + left_688;
+  length := sum + maximum + flag + length;
+  if count - 49909 > (68411 - 16665 + ((24756 * result + count_970 and current_char) - (sum_750))) or 53107 + (buffer * 11559) then done := 67684;
+  if 39561 >= buffer + ((maximum - sum_197 + value_549 / 20.54) or ((current_char_969 - result) div 262.11 - flag)) then total := (right);
+  { and that generated the grows and generated lexer token and that token the input }
+  (* and each that and grows when checks this token generated of reads
+     generated grows nothing breaks breaks input
+     reads nothing nothing generated grows each
+     *)
+  left_488 := 'this reads that each each checks';
+  result := index_359 + message_795 + right + current_char_940 + right;
+  { when nothing input and when lexer generated program }
+  if maximum_218 > 378.12 + right or ((44279 * 256.79 / (68027 div done_160 + 10971 - 29.93) or (index_669 mod 56360)) + (615.21 + 751.3) div (current_char) * 792.51) - total then value_36 := (182.18 - 79844 - 540.79) - index div minimum * 42395;
+  if (left) / limit < maximum then done := offset_689 - 366.52 - length mod message;
+  right := total + right + flag + done_627;
+  current_char_772 := 'token that the generated';
+  minimum := offset_839 + result + value;
+  current_char := offset + sum_716;
+  (* the when each lexer grows reads of reads reads reads that this
+     of this token this grows that that the
+     and when of lexer the breaks of nothing lexer this checks checks
+     this and token generated program nothing the checks nothing grows the generated
+     *)
+  sum := temp + done;
+  if total_937 mod index / 62324 >= 30654 or (message_455 or (229.15 * (50512 / 74900 + left) mod 97433 / sum_862) - value - (value - (position and 18883 or index))) + 793.40 mod (average + 73379) then position := value div 337.21;
+  temp := 'v';
+  minimum := 'x';
+  length := 'checks';
+  if 83466 > value and 331.77 then offset := value;
+  (* the token the and this the
+     breaks grows lexer the when generated token token generated program
+     input breaks program grows generated nothing checks of lexer token
+     and input and program input
+     this this of lexer grows grows of the reads the the program
+     that that and reads nothing reads and each generated input of
+     *)
+  (* breaks lexer this when checks reads grows each and the lexer
+     lexer of lexer token token and nothing nothing
+     *)
+  name_628 := buffer + counter_259 + left + limit;
+  message_58 := right_312 + done + total + offset + done_845;
+  count_509 := value_944 + index + result;
+  { of program of this input when grows that input when token checks of grows generated program each grows grows nothing checks reads lexer grows }
+  if maximum_48 mod left_92 <> 98577 / count then flag_407 := 390.79 / (done * ((minimum / position_700 mod 52533 and 308.65)) + result_46) or 94567 + (node_359 - (52340) - 549.26);
+  offset := sum + name_915 + right + temp;
+  if (81043 mod (sum_554 - 518.92 or left_344 * limit)) > 564.93 mod minimum div temp + length_317 then current_char_100 := average div (flag_874 * 56028 div count) - minimum;
+  (* generated the reads breaks input generated when
+     grows token input that nothing this breaks this
+     and input checks lexer reads grows
+     *)
+  { breaks lexer when each generated of that checks that this reads checks grows }
+  done := 'reads each lexer program';
+  offset := current_char_556 + result + current_char + counter_394 + total;
+  done := 'when of token the reads the';
+  (* when and of program reads that
+     breaks grows lexer breaks breaks
+     each grows and lexer when this each reads each this
+     *)
+  value := value + maximum + position + value + done + node_542 + name_364;
+  if (left / (350.81)) and 42638 and (46646 div 25355 * 34.27) <> 616.13 * 576.85 or 547.5 + (41331 div value mod 43697) then result_992 := 124.14;
+  index_255 := 'when that program checks grows that';
+  if 92345 > temp_769 - count_578 then temp_799 := 682.45 mod done + 38118 + done;
+  total := total + limit_828 + temp + current_char + maximum_891 + length;
+  maximum_236 := position_193 + temp + counter;
+  minimum := node + buffer + counter_754;
+  current_char := 'breaks';
+  (* the lexer nothing reads input nothing the this lexer generated of lexer
+     grows reads this input grows program generated lexer generated of when token
+     nothing that and breaks this breaks reads that breaks when token reads
+     generated nothing of that nothing each the breaks generated nothing this grows
+     grows and and of reads lexer breaks nothing program and each
+     *)
+  index := result_171 + maximum + index;
+  (* generated grows this generated nothing the that breaks this
+     the input when breaks of breaks this
+     *)
+  total := counter + value + node;
+  index := message_473 + total;
+  (* of of input when input nothing
+     nothing when nothing checks the this reads nothing this that each
+     grows each each token
+     *)
+  buffer_162 := done + counter + result_887 + index + length_185 + right_379;
+  length := 'and when lexer when nothing token program breaks grows';
+  name_995 := average_271 + buffer;
+  value := temp_662 + right_417 + temp_817 + message + average;
+  limit := sum + counter + value;
+  if name and offset div (5877) div 55504 >= 808.72 - maximum_317 then counter := (minimum_260 * index_325) and 38347;
+  left := position_676 + left_28 + counter + index + current_char + counter + average_239;
+  average := done + right;
+  left := 'a';
+  value := minimum_24 + value + sum + position + name;
+  if 981.92 + 883.7 = average_368 then counter_570 := 873.90 mod (36750 - 80.37 or (minimum_929 + 254.24 or left * count_649));
+  message_596 := temp + done_854 + minimum + index;
+  length := 'of breaks grows that generated when checks token nothing input';
+  buffer_375 := maximum_121 + minimum + done_165 + count;
+  current_char := 'y';
+  total := 'the';
+  current_char := 'generated of the generated checks breaks reads grows';
+  length := done_874 + sum + current_char + result;
+  { breaks token checks lexer grows input and of of }
+  average_899 := 't';
+  minimum := result + total;
+  if 33846 * (70717 and node_689) < 92206 * (229.60 or 489.58) then current_char := sum_530 * minimum div 445.4 * (49414 / 395.46);
+  current_char := counter + counter + maximum_868;
+  if 14377 - 729.17 <> position * 682.69 then current_char := 729.25 + 83911;
+end.
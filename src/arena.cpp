@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+#include "include/arena.h"
+
+using namespace std;
+
+LexArena::LexArena(size_t initialSize, pmr::memory_resource* upstream)
+    : upstream(upstream), nextSize(max<size_t>(initialSize, 256)) {}
+
+LexArena::~LexArena() {
+    releaseBlocks();
+}
+
+void LexArena::addBlock(size_t atLeast) {
+    size_t size = max(nextSize, atLeast);
+    Block* block = (Block*)upstream->allocate(sizeof(Block) + size, alignof(max_align_t));
+    block->next = blocks;
+    block->size = size;
+    blocks = block;
+    pos = (char*)(block + 1);
+    end = pos + size;
+    nextSize = size * 2;
+}
+
+void LexArena::releaseBlocks() {
+    while (blocks != nullptr) {
+        Block* next = blocks->next;
+        upstream->deallocate(blocks, sizeof(Block) + blocks->size, alignof(max_align_t));
+        blocks = next;
+    }
+    pos = end = nullptr;
+}
+
+void* LexArena::do_allocate(size_t bytes, size_t alignment) {
+    uintptr_t at = ((uintptr_t)pos + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    if (pos == nullptr || at + bytes > (uintptr_t)end) {
+        addBlock(bytes + alignment);
+        at = ((uintptr_t)pos + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+    pos = (char*)(at + bytes);
+    return (void*)at;
+}
+
+void LexArena::reset() {
+    if (blocks != nullptr && blocks->next != nullptr) {
+        size_t total = capacity();
+        releaseBlocks();
+        nextSize = total;
+        addBlock(total);
+        return;
+    }
+    if (blocks != nullptr) {
+        pos = (char*)(blocks + 1);
+        end = pos + blocks->size;
+    }
+}
+
+size_t LexArena::capacity() const {
+    size_t total = 0;
+    for (Block* block = blocks; block != nullptr; block = block->next) {
+        total += block->size;
+    }
+    return total;
+}
+
+void* CountingResource::do_allocate(size_t bytes, size_t alignment) {
+    void* p = upstream->allocate(bytes, alignment);
+    allocated += bytes;
+    allocations++;
+    size_t now = current += bytes;
+    size_t highest = peak.load();
+    while (now > highest && !peak.compare_exchange_weak(highest, now)) {
+    }
+    return p;
+}
+
+void CountingResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    upstream->deallocate(p, bytes, alignment);
+    current -= bytes;
+}
+
+MemoryUsage CountingResource::usage() const {
+    MemoryUsage usage;
+    usage.allocated = allocated.load();
+    usage.allocations = allocations.load();
+    usage.current = current.load();
+    usage.peak = peak.load();
+    return usage;
+}
+
+void printMemoryPhase(ostream& out, const char* phase, const MemoryUsage& before, const MemoryUsage& after) {
+    char line[160];
+    snprintf(line, sizeof(line), "  %-8s %12zu bytes %10zu allocations   peak %12zu bytes",
+             phase, after.allocated - before.allocated, after.allocations - before.allocations, after.peak);
+    out << line << endl;
+}
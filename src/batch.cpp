@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unistd.h>
+
+#include "include/batch.h"
+#include "include/read_ahead.h"
+#include "include/thread_pool.h"
+
+using namespace std;
+
+bool collectInputs(const vector<string>& paths, vector<string>& files) {
+    namespace fs = std::filesystem;
+    for (const string& path : paths) {
+        error_code ec;
+        if (!fs::is_directory(path, ec)) {
+            files.push_back(path);
+            continue;
+        }
+
+        vector<string> found;
+        for (fs::recursive_directory_iterator it(path, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->is_regular_file(ec) && it->path().extension() == ".pas") {
+                found.push_back(it->path().string());
+            }
+        }
+        if (ec) {
+            cout << "Failed to read directory: " << path << endl;
+            return false;
+        }
+        sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
+    }
+    return true;
+}
+
+// Finished output of one file, waiting for its turn to be written
+struct FileResult {
+    unique_ptr<OutputBuffer> output;
+    string errors;          // diagnostics, when the tokens own stdout
+    size_t tokens = 0;
+    size_t bytes = 0;
+    bool ok = false;
+    bool ready = false;
+};
+
+static void appendLine(OutputBuffer& out, const string& line) {
+    out.append(line.data(), line.size());
+    out.append('\n');
+}
+
+// Lex one file; source is null if it could not be read. Symbol ids are
+// numbered per file so they do not depend on which thread interned a name
+// first; the file's names are then added to the run's symbols.
+// source is null when the file could not be read, error says why
+static void lexOne(const Lexer& lexer, const string& path, const SourceBuffer* source, int error,
+                   const BatchOptions& options, SymbolTable& symbols, pmr::memory_resource* memory,
+                   FileResult& result) {
+    OutputFormat format = options.format;
+    result.output.reset(new OutputBuffer());
+    OutputBuffer& out = *result.output;
+    bool text = format == TEXT_FORMAT || format == COUNT_FORMAT;
+
+    if (text) {
+        appendLine(out, "Processing file: " + path);
+        appendLine(out, "----------------------------------------");
+    }
+
+    if (source == nullptr) {
+        appendLine(out, "Failed to open file: " + path + ": " + strerror(error));
+        return;
+    }
+    if (source->size() > MAX_SOURCE_SIZE) {
+        appendLine(out, "File larger than 4 GiB: " + path);
+        return;
+    }
+    result.bytes = source->size();
+
+    if (format == JSONL_FORMAT) {
+        // A file marker line separates the token lines of consecutive files
+        out.append("{\"file\":", 8);
+        appendJsonString(out, path);
+        out.append("}\n", 2);
+    }
+
+    unique_ptr<TokenWriter> writer = createTokenWriter(format, out);
+    writer->setSource(source->begin());
+    // Errors are always collected: the lexer's exit(1) would end the whole
+    // run from a worker thread. Without --recover a file's tokens stop at
+    // its first error, which is reported as the file's failure.
+    Diagnostics diagnostics;
+    SymbolTable fileSymbols;
+    auto stopsHere = [&](const TokenView& token) {
+        return !options.recover && !diagnostics.empty() && token.offset >= diagnostics[0].offset;
+    };
+    if (options.cache != nullptr) {
+        // Interned as written, so names after the first error do not count
+        TokenStream cached = options.cache->lex(lexer, *source, &diagnostics, nullptr, memory);
+        for (TokenView token : cached) {
+            if (stopsHere(token)) break;
+            if (token.type == IDENTIFIER) {
+                token.symbol = fileSymbols.intern(token.text);
+            }
+            writer->write(token);
+        }
+    } else {
+        for (const TokenView& token : lexer.tokens(*source, 0, &diagnostics, &fileSymbols, memory)) {
+            if (stopsHere(token)) break;
+            writer->write(token);
+        }
+    }
+    writer->finish();
+    if (!options.recover && diagnostics.size() > 1) {
+        Diagnostic first = diagnostics[0];
+        diagnostics.clear();
+        diagnostics.add(first.kind, first.offset, first.length);
+    }
+    symbols.internAll(fileSymbols);
+    result.tokens = writer->getCount();
+    result.ok = diagnostics.empty();
+
+    if (text) {
+        appendLine(out, "----------------------------------------");
+    }
+    diagnostics.locate(source->begin(), source->size());
+    for (const Diagnostic& diagnostic : diagnostics) {
+        string line = diagnostic.message(source->begin());
+        if (text) {
+            appendLine(out, line);
+        } else {
+            result.errors += path + ": " + line + "\n";
+        }
+    }
+    if (text) {
+        appendLine(out, "Total tokens: " + to_string(result.tokens));
+    }
+}
+
+int runBatch(const Lexer& lexer, const vector<string>& files, const BatchOptions& options) {
+    bool data_on_stdout = options.format == JSONL_FORMAT || options.format == BINARY_FORMAT;
+    ostream& info = data_on_stdout ? cerr : cout;
+    info.flush();
+    fflush(stdout);
+
+    vector<FileResult> results(files.size());
+    SymbolTable symbols;        // names of all files, for the distinct identifier count
+    mutex readyLock;
+    condition_variable readyChanged;
+
+    auto start_time = chrono::steady_clock::now();
+    unique_ptr<ReadAhead> readAhead;
+    if (options.readAhead > 0) {
+        readAhead.reset(new ReadAhead(files, options.readAhead));
+    }
+    WorkStealingPool pool(options.threads);
+
+    // Idle arenas; a task takes one or makes one, so there are at most as
+    // many as tasks ever ran at once, and once they have grown to fit the
+    // files no task allocates from upstream
+    pmr::memory_resource* upstream = options.memory != nullptr ? options.memory : pmr::get_default_resource();
+    MemoryUsage usageBefore = options.memory != nullptr ? options.memory->usage() : MemoryUsage();
+    vector<unique_ptr<LexArena>> arenas;
+    mutex arenaLock;
+
+    for (size_t i = 0; i < files.size(); i++) {
+        pool.submit([&, i] {
+            unique_ptr<LexArena> arena;
+            {
+                lock_guard<mutex> guard(arenaLock);
+                if (!arenas.empty()) {
+                    arena = move(arenas.back());
+                    arenas.pop_back();
+                }
+            }
+            if (!arena) {
+                arena.reset(new LexArena(64 * 1024, upstream));
+            }
+
+            // With read-ahead a task lexes whichever file comes next, in
+            // list order, so no worker waits on a file not yet being read
+            size_t index = i;
+            if (readAhead) {
+                PrefetchedFile file;
+                readAhead->take(file);
+                index = file.index;
+                SourceBuffer source(file.data, file.size);
+                lexOne(lexer, files[index], file.ok ? &source : nullptr, file.error, options, symbols, arena.get(),
+                       results[index]);
+                readAhead->release(file);
+            } else {
+                SourceBuffer source;
+                bool ok = read_file(files[index].c_str(), source);
+                lexOne(lexer, files[index], ok ? &source : nullptr, ok ? 0 : errno, options, symbols, arena.get(),
+                       results[index]);
+            }
+            arena->reset();
+            {
+                lock_guard<mutex> guard(arenaLock);
+                arenas.push_back(move(arena));
+            }
+            lock_guard<mutex> guard(readyLock);
+            results[index].ready = true;
+            readyChanged.notify_all();
+        });
+    }
+
+    // Reorder buffer: emit each file as soon as all files before it are out
+    OutputBuffer stdoutBuffer(STDOUT_FILENO);
+    size_t total_tokens = 0;
+    size_t total_bytes = 0;
+    size_t failed = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        {
+            unique_lock<mutex> lock(readyLock);
+            readyChanged.wait(lock, [&] { return results[i].ready; });
+        }
+        FileResult& result = results[i];
+        stdoutBuffer.append(result.output->contents(), result.output->length());
+        result.output.reset();
+        if (!result.errors.empty()) {
+            cerr << result.errors;
+        }
+        total_tokens += result.tokens;
+        total_bytes += result.bytes;
+        if (!result.ok) failed++;
+    }
+    stdoutBuffer.flush();
+    pool.wait();
+    auto end_time = chrono::steady_clock::now();
+
+    double seconds = chrono::duration<double>(end_time - start_time).count();
+    if (seconds <= 0) seconds = 1e-9;
+    info << "========================================" << endl;
+    info << "Files: " << files.size() << " (" << failed << " failed), threads: " << pool.size();
+    if (readAhead) {
+        info << ", read-ahead: " << options.readAhead << " (" << readAhead->backend() << ")";
+    }
+    info << endl;
+    info << "Total tokens: " << total_tokens << ", bytes: " << total_bytes
+         << ", distinct identifiers: " << symbols.size() << endl;
+    info << "Elapsed: " << seconds * 1000.0 << " ms, "
+         << files.size() / seconds << " files/s, "
+         << total_bytes / seconds / (1024.0 * 1024.0) << " MB/s, "
+         << total_tokens / seconds << " tokens/s" << endl;
+    if (options.cache != nullptr) {
+        options.cache->printStats(info);
+    }
+    if (options.memory != nullptr) {
+        size_t reserved = 0;
+        for (const unique_ptr<LexArena>& arena : arenas) {
+            reserved += arena->capacity();
+        }
+        info << "Lexer memory: " << arenas.size() << " arena(s), " << reserved << " bytes reserved" << endl;
+        printMemoryPhase(info, "lex", usageBefore, options.memory->usage());
+    }
+
+    if (outputFailed(stdoutBuffer)) {
+        return 1;
+    }
+    return failed == 0 ? 0 : 1;
+}
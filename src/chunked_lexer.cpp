@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "include/chunked_lexer.h"
+#include "include/thread_pool.h"
+
+using namespace std;
+
+enum ChunkStop {
+    STOP_LIMIT,         // next lexeme starts in the following chunk
+    STOP_END,           // ran off the end of the source
+    STOP_ERROR          // hit a lexeme that does not match
+};
+
+// Result of lexing one chunk speculatively
+struct Chunk {
+    size_t begin = 0;               // guessed token boundary
+    size_t limit = 0;               // lexemes starting here belong to the next chunk
+    vector<uint32_t> starts;        // offset of every lexeme, comments included
+    vector<uint32_t> firstToken;    // tokens.size() when that lexeme started
+    TokenStream tokens;
+    size_t endPos = 0;              // where the last lexeme ended
+    ChunkStop stop = STOP_END;
+};
+
+// Identifiers are not interned here: a chunk may be thrown away, and ids
+// handed out from several threads would depend on their timing
+static void speculate(const Lexer& lexer, const SourceBuffer& source, size_t from, Chunk& chunk) {
+    chunk.starts.clear();
+    chunk.firstToken.clear();
+    chunk.tokens = TokenStream(source.begin());
+
+    SourceCursor in(source, from);
+    TokenView token;
+    for (;;) {
+        size_t before = chunk.tokens.size();
+        ScanResult result = lexer.scanLexeme(in, token);
+        if (result == SCAN_END) {
+            chunk.stop = STOP_END;
+            break;
+        }
+        if (result == SCAN_ERROR) {
+            chunk.stop = STOP_ERROR;
+            break;
+        }
+
+        uint32_t start = token.offset;
+        if (start >= chunk.limit) {
+            in.pos = in.begin + start;
+            chunk.stop = STOP_LIMIT;
+            break;
+        }
+        chunk.starts.push_back(start);
+        chunk.firstToken.push_back((uint32_t)before);
+        if (result == SCAN_TOKEN) {
+            chunk.tokens.push(token);
+        }
+    }
+    chunk.endPos = (size_t)in.offset();
+}
+
+// Offset just past the first occurrence of pattern in [from, limit), or 0
+static size_t after(const SourceBuffer& source, size_t from, size_t limit, const char* pattern) {
+    const char* first = source.begin() + from;
+    const char* last = source.begin() + limit;
+    size_t length = strlen(pattern);
+    const char* found = search(first, last, pattern, pattern + length);
+    return found == last ? 0 : (size_t)(found - source.begin()) + length;
+}
+
+static void lexChunk(const Lexer& lexer, const SourceBuffer& source, Chunk& chunk) {
+    speculate(lexer, source, chunk.begin, chunk);
+    if (chunk.stop != STOP_ERROR || chunk.begin == 0) {
+        return;
+    }
+
+    // The guess most likely landed inside a comment or literal. Try resuming
+    // after the first place each of them could end, keeping the first
+    // attempt that gets through the chunk.
+    const char* closers[] = {"}", "*)", "'"};
+    for (const char* closer : closers) {
+        size_t resume = after(source, chunk.begin, chunk.limit, closer);
+        if (resume == 0) continue;
+
+        Chunk retry;
+        retry.begin = chunk.begin;
+        retry.limit = chunk.limit;
+        speculate(lexer, source, resume, retry);
+        if (retry.stop != STOP_ERROR) {
+            chunk = std::move(retry);
+            return;
+        }
+    }
+}
+
+size_t lexChunked(const Lexer& lexer, const SourceBuffer& source, size_t chunks, TokenStream& tokens,
+                  SymbolTable* symbols) {
+    size_t size = source.size();
+    if (chunks > size / MIN_CHUNK_SIZE) chunks = size / MIN_CHUNK_SIZE;
+    if (chunks < 1) chunks = 1;
+
+    // Guess boundaries at line starts, dropping chunks that end up empty
+    vector<Chunk> parts;
+    for (size_t i = 0; i < chunks; i++) {
+        size_t begin = size * i / chunks;
+        if (i > 0) {
+            const char* newline = (const char*)memchr(source.begin() + begin, '\n', size - begin);
+            begin = newline ? (size_t)(newline - source.begin()) + 1 : size;
+            if (begin >= size || begin <= parts.back().begin) continue;
+            parts.back().limit = begin;
+        }
+        parts.push_back(Chunk());
+        parts.back().begin = begin;
+    }
+    parts.back().limit = size;
+
+    if (parts.size() == 1) {
+        lexChunk(lexer, source, parts[0]);
+    } else {
+        WorkStealingPool pool(parts.size());
+        for (Chunk& chunk : parts) {
+            pool.submit([&lexer, &source, &chunk] { lexChunk(lexer, source, chunk); });
+        }
+        pool.wait();
+    }
+
+    // Stitch: pos is always the true position of the sequential lexer
+    size_t pos = 0;
+    TokenView token;
+    for (Chunk& chunk : parts) {
+        if (pos >= chunk.limit) continue;
+
+        SourceCursor in(source, pos);
+        in.symbols = symbols;
+        for (;;) {
+            ScanResult result = lexer.scanLexeme(in, token);
+            if (result == SCAN_END) {
+                return size;
+            }
+            if (result == SCAN_ERROR) {
+                return (size_t)in.offset();
+            }
+
+            uint32_t start = token.offset;
+            if (start >= chunk.limit) {
+                pos = start;
+                break;
+            }
+
+            auto it = lower_bound(chunk.starts.begin(), chunk.starts.end(), start);
+            if (it != chunk.starts.end() && *it == start) {
+                // In sync with the speculative pass: take its tokens, interning
+                // their identifiers here in output order
+                for (size_t i = chunk.firstToken[it - chunk.starts.begin()]; i < chunk.tokens.size(); i++) {
+                    TokenView adopted = chunk.tokens[i];
+                    if (adopted.type == IDENTIFIER && symbols != nullptr) {
+                        adopted.symbol = symbols->intern(adopted.text);
+                    }
+                    tokens.push(adopted);
+                }
+                if (chunk.stop == STOP_END) {
+                    return size;
+                }
+                if (chunk.stop == STOP_ERROR) {
+                    return chunk.endPos;
+                }
+                pos = chunk.endPos;
+                break;
+            }
+
+            // Not in sync yet, keep the sequentially lexed lexeme
+            if (result == SCAN_TOKEN) {
+                tokens.push(token);
+            }
+        }
+    }
+    return size;
+}
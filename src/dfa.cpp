@@ -4,11 +4,33 @@
 #include <vector>
 #include <algorithm>
 #include <utility>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+#include "include/source.h"
 
 using namespace std;
 
+DFA::DFA(pmr::memory_resource* memory)
+    : table(memory), accept_bits(memory), state_tags(memory), accel_slot(memory), accel_stops(memory),
+      lookahead(memory), state_flags(memory) {}
+
 void DFA::addTransition(const string& from_state, char input, const string& to_state) {
-    transitions[make_pair(from_state, input)] = to_state;
+    auto key = make_pair(from_state, input);
+    auto it = transitions.find(key);
+    if (it != transitions.end()) {
+        if (it->second == to_state) {
+            stats.duplicate_transitions++;
+        } else {
+            // The later rule wins, as before, but no longer silently
+            stats.conflicting_transitions++;
+            fprintf(stderr, "WARNING: line %d: transition %s '%c' redefined from %s to %s\n",
+                    current_line, from_state.c_str(), input, it->second.c_str(), to_state.c_str());
+        }
+    }
+    transitions[key] = to_state;
 }
 
 void DFA::setStartState(const string& state) {
@@ -22,6 +44,11 @@ void DFA::addFinalState(const string& state) {
 }
 
 string DFA::getNextState(const string& current_state, char input) const {
+    if (!state_names.empty()) {
+        int id = getStateId(current_state);
+        if (id < 0) return "ERROR";
+        return state_names[next((uint16_t)id, (unsigned char)input)];
+    }
     auto it = transitions.find(make_pair(current_state, input));
     if (it != transitions.end()) {
         return it->second;
@@ -34,16 +61,147 @@ string DFA::getStartState() const {
 }
 
 bool DFA::isFinalState(const string& state) const {
+    if (!state_names.empty()) {
+        int id = getStateId(state);
+        return id > 0 && isAccepting((uint16_t)id);
+    }
     return find(final_states.begin(), final_states.end(), state) != final_states.end();
 }
 
+// Rules-file prefixes for reserved words and the token type they produce
+static const pair<string, Type> RESERVED_WORD_CATEGORIES[] = {
+    {"Keyword =", KEYWORD},
+    {"Logical_operator =", LOGICAL_OPERATOR},
+    {"Arithmetic_operator =", ARITHMETIC_OPERATOR}
+};
+
+// Split a comma separated list, trimming whitespace around each item
+static vector<string> splitList(const string& list) {
+    vector<string> items;
+    istringstream ss(list);
+    string item;
+    while (getline(ss, item, ',')) {
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+// One byte of a transition input: a named control character, 0xHH, or
+// the character itself
+static bool parseByte(const string& text, unsigned char& byte) {
+    if (text == "SPACE") byte = ' ';
+    else if (text == "NEWLINE") byte = '\n';
+    else if (text == "TAB") byte = '\t';
+    else if (text == "CR") byte = '\r';
+    else if (text.length() == 1) byte = (unsigned char)text[0];
+    else if (text.length() == 4 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X') &&
+             isxdigit((unsigned char)text[2]) && isxdigit((unsigned char)text[3])) {
+        byte = (unsigned char)strtol(text.c_str() + 2, nullptr, 16);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Expand the input column of a transition rule into the bytes it stands for:
+//   x, SPACE, NEWLINE, TAB, CR, 0xHH      one byte
+//   a-z, 0x80-0xBF                        an inclusive byte range
+//   ANY_EXCEPT(chars)                     every ASCII byte but the listed ones
+//                                         (or one named byte), plus UTF8;
+//                                         only ASCII bytes can be listed
+//   UTF8                                  any well-formed multi-byte UTF-8
+//                                         sequence, see addUtf8Transitions
+static bool parseInput(const string& text, vector<unsigned char>& bytes, bool& utf8) {
+    unsigned char byte, last;
+    utf8 = false;
+    if (parseByte(text, byte)) {
+        bytes.push_back(byte);
+        return true;
+    }
+    if (text == "UTF8") {
+        utf8 = true;
+        return true;
+    }
+    if (text.compare(0, 11, "ANY_EXCEPT(") == 0 && text.back() == ')') {
+        string except = text.substr(11, text.length() - 12);
+        bool excluded[256] = {};
+        if (parseByte(except, byte) && except.length() > 1) {
+            excluded[byte] = true;
+        } else {
+            for (char c : except) excluded[(unsigned char)c] = true;
+        }
+        // Multi-byte characters come in through UTF8 as a whole
+        for (int c = 128; c < 256; c++) {
+            if (excluded[c]) return false;
+        }
+        for (int c = 0; c < 128; c++) {
+            if (!excluded[c]) bytes.push_back((unsigned char)c);
+        }
+        utf8 = true;
+        return true;
+    }
+    size_t dash = text.find('-', 1);
+    if (dash != string::npos && parseByte(text.substr(0, dash), byte) && parseByte(text.substr(dash + 1), last) &&
+        byte <= last) {
+        for (int c = byte; c <= last; c++) bytes.push_back((unsigned char)c);
+        return true;
+    }
+    return false;
+}
+
+// Accept one multi-byte UTF-8 character from from_state and go to to_state.
+// The continuation bytes run through helper states named after the target,
+// so every source state with the same target shares them. Only well-formed
+// sequences are accepted: no overlong forms, surrogates or values past U+10FFFF.
+void DFA::addUtf8Transitions(const string& from_state, const string& to_state) {
+    auto addRange = [this](const string& from, int first, int last, const string& to) {
+        for (int c = first; c <= last; c++) addTransition(from, (char)c, to);
+    };
+    string tail1 = to_state + ".utf8_1";    // one continuation byte left
+    string tail2 = to_state + ".utf8_2";
+    string tail3 = to_state + ".utf8_3";
+    string afterE0 = to_state + ".utf8_e0";
+    string afterED = to_state + ".utf8_ed";
+    string afterF0 = to_state + ".utf8_f0";
+    string afterF4 = to_state + ".utf8_f4";
+    
+    addRange(from_state, 0xC2, 0xDF, tail1);
+    addRange(from_state, 0xE0, 0xE0, afterE0);
+    addRange(from_state, 0xE1, 0xEC, tail2);
+    addRange(from_state, 0xED, 0xED, afterED);
+    addRange(from_state, 0xEE, 0xEF, tail2);
+    addRange(from_state, 0xF0, 0xF0, afterF0);
+    addRange(from_state, 0xF1, 0xF3, tail3);
+    addRange(from_state, 0xF4, 0xF4, afterF4);
+    
+    // The helper states are shared, so only define them once
+    if (transitions.count(make_pair(tail1, (char)0x80)) != 0) return;
+    addRange(tail1, 0x80, 0xBF, to_state);
+    addRange(tail2, 0x80, 0xBF, tail1);
+    addRange(tail3, 0x80, 0xBF, tail2);
+    addRange(afterE0, 0xA0, 0xBF, tail1);
+    addRange(afterED, 0x80, 0x9F, tail1);
+    addRange(afterF0, 0x90, 0xBF, tail2);
+    addRange(afterF4, 0x80, 0x8F, tail2);
+}
+
+void DFA::addReservedWord(const string& word, Type type) {
+    reserved_words.push_back(make_pair(word, type));
+}
+
 bool DFA::loadDFAFromFile(const string& filename) {
     ifstream file(filename);
     if (!file.is_open()) return false;
     
     string line;
+    current_line = 0;
     
     while (getline(file, line)) {
+        current_line++;
         // Skip empty lines and comments
         if (line.empty() || line[0] == '#') continue;
         
@@ -62,52 +220,744 @@ bool DFA::loadDFAFromFile(const string& filename) {
         
         // Handle final states definition
         if (line.find("Final_state =") == 0) {
-            size_t pos = line.find('=');
-            if (pos != string::npos) {
-                string states_str = line.substr(pos + 1);
-                // Trim whitespace
-                states_str.erase(0, states_str.find_first_not_of(" \t"));
-                states_str.erase(states_str.find_last_not_of(" \t") + 1);
-                
-                // Split by comma and add each final state
-                istringstream ss(states_str);
-                string state;
-                while (getline(ss, state, ',')) {
-                    // Trim whitespace from each state
-                    state.erase(0, state.find_first_not_of(" \t"));
-                    state.erase(state.find_last_not_of(" \t") + 1);
-                    if (!state.empty()) {
-                        addFinalState(state);
-                    }
-                }
+            for (const string& state : splitList(line.substr(line.find('=') + 1))) {
+                addFinalState(state);
             }
             continue;
         }
         
+        // Handle extra reserved words, e.g. "Keyword = string, record"
+        bool reserved = false;
+        for (const auto& category : RESERVED_WORD_CATEGORIES) {
+            if (line.find(category.first) == 0) {
+                for (const string& word : splitList(line.substr(line.find('=') + 1))) {
+                    addReservedWord(word, category.second);
+                }
+                reserved = true;
+                break;
+            }
+        }
+        if (reserved) continue;
+        
         // Handle transition rules
         istringstream iss(line);
         string from_state, input_str, to_state;
         
         if (iss >> from_state >> input_str >> to_state) {
-            char input;
-            if (input_str == "SPACE") {
-                input = ' ';
-            } else if (input_str == "NEWLINE") {
-                input = '\n';
-            } else if (input_str == "TAB") {
-                input = '\t';
-            } else if (input_str == "CR") {
-                input = '\r';
-            } else if (input_str.length() == 1) {
-                input = input_str[0];
-            } else {
-                continue; // Skip invalid transitions
+            vector<unsigned char> inputs;
+            bool utf8;
+            if (!parseInput(input_str, inputs, utf8)) {
+                fprintf(stderr, "WARNING: line %d: invalid input %s, transition skipped\n",
+                        current_line, input_str.c_str());
+                continue;
+            }
+            for (unsigned char input : inputs) {
+                addTransition(from_state, (char)input, to_state);
+            }
+            if (utf8) {
+                addUtf8Transitions(from_state, to_state);
             }
-            addTransition(from_state, input, to_state);
         }
     }
     
     file.close();
     
-    return !transitions.empty();
+    if (transitions.empty()) return false;
+    return compile();
+}
+
+int DFA::getStateId(const string& state) const {
+    auto it = state_ids.find(state);
+    if (it != state_ids.end()) {
+        return it->second;
+    }
+    return -1;
+}
+
+uint16_t DFA::internState(const string& state) {
+    auto it = state_ids.find(state);
+    if (it != state_ids.end()) {
+        return it->second;
+    }
+    uint16_t id = (uint16_t)state_names.size();
+    state_names.push_back(state);
+    state_ids[state] = id;
+    return id;
+}
+
+// Build the compiled table from the string-keyed rules:
+//   1. number the states and flatten the transitions into a [state][256] table
+//   2. drop states unreachable from the start state and states that can
+//      never reach an accepting state (dead states collapse into ERROR)
+//   3. merge equivalent states with Hopcroft's algorithm
+//   4. group byte values that behave identically into equivalence classes
+bool DFA::compile() {
+    state_names.clear();
+    state_ids.clear();
+    state_tags.clear();
+    internState("ERROR");
+    
+    internState(start_state);
+    for (const auto& t : transitions) {
+        internState(t.first.first);
+        internState(t.second);
+    }
+    for (const string& state : final_states) {
+        internState(state);
+    }
+    
+    if (state_names.size() > 0xFFFF) {
+        printf("ERROR: DFA has too many states (%zu)\n", state_names.size());
+        return false;
+    }
+    
+    size_t count = state_names.size();
+    vector<uint16_t> full(count * 256, ERROR_STATE);
+    for (const auto& t : transitions) {
+        uint16_t from = state_ids[t.first.first];
+        unsigned char input = (unsigned char)t.first.second;
+        full[((size_t)from << 8) | input] = state_ids[t.second];
+    }
+    vector<bool> accepting(count, false);
+    for (const string& state : final_states) {
+        accepting[state_ids[state]] = true;
+    }
+    
+    stats.states_before = count - 1;
+    stats.unreachable_states = 0;
+    stats.dead_states = 0;
+    
+    // Forward reachability from the start state
+    vector<bool> reachable(count, false);
+    vector<uint16_t> work;
+    reachable[state_ids[start_state]] = true;
+    work.push_back(state_ids[start_state]);
+    while (!work.empty()) {
+        uint16_t state = work.back();
+        work.pop_back();
+        for (int c = 0; c < 256; c++) {
+            uint16_t target = full[((size_t)state << 8) | c];
+            if (!reachable[target]) {
+                reachable[target] = true;
+                work.push_back(target);
+            }
+        }
+    }
+    
+    // Backward reachability from the accepting states
+    vector<vector<uint16_t>> predecessors(count);
+    for (size_t state = 0; state < count; state++) {
+        for (int c = 0; c < 256; c++) {
+            predecessors[full[(state << 8) | c]].push_back((uint16_t)state);
+        }
+    }
+    vector<bool> alive(count, false);
+    for (size_t state = 0; state < count; state++) {
+        if (accepting[state]) {
+            alive[state] = true;
+            work.push_back((uint16_t)state);
+        }
+    }
+    while (!work.empty()) {
+        uint16_t state = work.back();
+        work.pop_back();
+        for (uint16_t from : predecessors[state]) {
+            if (!alive[from]) {
+                alive[from] = true;
+                work.push_back(from);
+            }
+        }
+    }
+    
+    // Useful states keep their id order; everything else maps to ERROR
+    vector<uint16_t> useful;
+    vector<int> compact(count, -1);
+    compact[ERROR_STATE] = 0;
+    useful.push_back(ERROR_STATE);
+    for (size_t state = 1; state < count; state++) {
+        if (!reachable[state]) {
+            stats.unreachable_states++;
+        } else if (!alive[state]) {
+            stats.dead_states++;
+        } else {
+            compact[state] = (int)useful.size();
+            useful.push_back((uint16_t)state);
+        }
+    }
+    if (compact[state_ids[start_state]] < 0) {
+        printf("ERROR: No accepting state is reachable from %s\n", start_state.c_str());
+        return false;
+    }
+    
+    size_t n = useful.size();
+    vector<uint16_t> trimmed(n * 256, ERROR_STATE);
+    for (size_t i = 0; i < n; i++) {
+        for (int c = 0; c < 256; c++) {
+            int target = compact[full[((size_t)useful[i] << 8) | c]];
+            trimmed[(i << 8) | c] = (uint16_t)(target < 0 ? 0 : target);
+        }
+    }
+    
+    // Initial partition: ERROR, non-accepting, then accepting states grouped by
+    // token tag. Accepting states without a known tag are never merged.
+    vector<int> block_of(n);
+    vector<vector<uint16_t>> blocks;
+    map<pair<int, int>, int> initial;
+    for (size_t i = 0; i < n; i++) {
+        pair<int, int> key;
+        const string& name = state_names[useful[i]];
+        auto tag = tag_names.find(name);
+        if (i == 0) {
+            key = make_pair(0, 0);
+        } else if (!accepting[useful[i]]) {
+            key = make_pair(1, 0);
+        } else if (tag != tag_names.end()) {
+            key = make_pair(2, tag->second);
+        } else {
+            key = make_pair(3, (int)i);
+        }
+        auto it = initial.find(key);
+        if (it == initial.end()) {
+            it = initial.insert(make_pair(key, (int)blocks.size())).first;
+            blocks.push_back(vector<uint16_t>());
+        }
+        block_of[i] = it->second;
+        blocks[it->second].push_back((uint16_t)i);
+    }
+    
+    // Hopcroft refinement over the byte alphabet
+    vector<vector<uint16_t>> inverse(n * 256);
+    for (size_t i = 0; i < n; i++) {
+        for (int c = 0; c < 256; c++) {
+            inverse[((size_t)trimmed[(i << 8) | c] << 8) | c].push_back((uint16_t)i);
+        }
+    }
+    vector<bool> in_work(blocks.size(), true);
+    vector<int> pending;
+    for (size_t b = 0; b < blocks.size(); b++) {
+        pending.push_back((int)b);
+    }
+    vector<char> marked(n, 0);
+    while (!pending.empty()) {
+        int splitter = pending.back();
+        pending.pop_back();
+        in_work[splitter] = false;
+        vector<uint16_t> members = blocks[splitter];
+        
+        for (int c = 0; c < 256; c++) {
+            vector<uint16_t> hit;
+            for (uint16_t target : members) {
+                for (uint16_t from : inverse[((size_t)target << 8) | c]) {
+                    if (!marked[from]) {
+                        marked[from] = 1;
+                        hit.push_back(from);
+                    }
+                }
+            }
+            if (hit.empty()) continue;
+            
+            map<int, vector<uint16_t>> touched;
+            for (uint16_t state : hit) {
+                touched[block_of[state]].push_back(state);
+                marked[state] = 0;
+            }
+            for (auto& entry : touched) {
+                int y = entry.first;
+                if (entry.second.size() == blocks[y].size()) continue;
+                
+                // Split y into the part reaching the splitter and the rest
+                vector<uint16_t> inside = entry.second;
+                vector<uint16_t> outside;
+                for (uint16_t state : inside) {
+                    marked[state] = 1;
+                }
+                for (uint16_t state : blocks[y]) {
+                    if (!marked[state]) outside.push_back(state);
+                }
+                for (uint16_t state : inside) {
+                    marked[state] = 0;
+                }
+                int z = (int)blocks.size();
+                blocks[y] = inside;
+                blocks.push_back(outside);
+                in_work.push_back(false);
+                for (uint16_t state : outside) {
+                    block_of[state] = z;
+                }
+                if (in_work[y]) {
+                    pending.push_back(z);
+                    in_work[z] = true;
+                } else {
+                    int smaller = inside.size() <= outside.size() ? y : z;
+                    pending.push_back(smaller);
+                    in_work[smaller] = true;
+                }
+            }
+        }
+    }
+    
+    // Renumber blocks: ERROR stays 0, the rest in order of first member
+    vector<int> block_id(blocks.size(), -1);
+    vector<uint16_t> representative;
+    for (size_t i = 0; i < n; i++) {
+        int b = block_of[i];
+        if (block_id[b] < 0) {
+            block_id[b] = (int)representative.size();
+            representative.push_back((uint16_t)i);
+        }
+    }
+    size_t merged = representative.size();
+    
+    vector<string> merged_names(merged);
+    map<string, uint16_t> merged_ids;
+    for (size_t i = 0; i < n; i++) {
+        uint16_t id = (uint16_t)block_id[block_of[i]];
+        const string& name = state_names[useful[i]];
+        if (!merged_names[id].empty()) merged_names[id] += "|";
+        merged_names[id] += name;
+        merged_ids[name] = id;
+    }
+    
+    // Byte equivalence classes over the minimised table
+    map<vector<uint16_t>, uint8_t> columns;
+    int class_total = 0;
+    for (int c = 0; c < 256; c++) {
+        vector<uint16_t> column(merged);
+        for (size_t id = 0; id < merged; id++) {
+            uint16_t target = trimmed[((size_t)representative[id] << 8) | c];
+            column[id] = (uint16_t)block_id[block_of[target]];
+        }
+        auto it = columns.find(column);
+        if (it == columns.end()) {
+            it = columns.insert(make_pair(column, (uint8_t)class_total++)).first;
+        }
+        class_of[c] = it->second;
+    }
+    class_count = (uint16_t)class_total;
+    class_shift = 0;
+    while ((1u << class_shift) < class_count) class_shift++;
+    
+    table.assign(merged << class_shift, ERROR_STATE);
+    for (int c = 0; c < 256; c++) {
+        for (size_t id = 0; id < merged; id++) {
+            uint16_t target = trimmed[((size_t)representative[id] << 8) | c];
+            table[(id << class_shift) | class_of[c]] = (uint16_t)block_id[block_of[target]];
+        }
+    }
+    
+    accept_bits.assign((merged + 63) / 64, 0);
+    state_tags.assign(merged, STATE_UNMAPPED);
+    for (size_t id = 0; id < merged; id++) {
+        uint16_t original = useful[representative[id]];
+        if (accepting[original]) {
+            accept_bits[id >> 6] |= (uint64_t)1 << (id & 63);
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        auto tag = tag_names.find(state_names[useful[i]]);
+        if (tag != tag_names.end()) {
+            state_tags[block_id[block_of[i]]] = tag->second;
+        }
+    }
+    if (tag_names.empty()) {
+        state_tags.clear();
+    }
+    
+    start_id = (uint16_t)block_id[block_of[compact[state_ids[start_state]]]];
+    state_names.swap(merged_names);
+    state_ids.swap(merged_ids);
+    state_ids["ERROR"] = ERROR_STATE;
+    state_names[ERROR_STATE] = "ERROR";
+    
+    stats.states_after = merged - 1;
+    stats.byte_classes = class_count;
+    buildAccelerators();
+    analyseLookahead();
+    return true;
+}
+
+// A state that loops on itself for all but a few printable bytes (comment
+// and literal bodies) can skip its run with a vector scan. '\n', '\t' and
+// '\r' are skipped too when the state loops on them, and so are bytes
+// >= 0x80 when it loops on all of them; any other byte outside printable
+// ASCII stops the scan and takes the ordinary table step.
+void DFA::buildAccelerators() {
+    size_t count = state_names.size();
+    accel_slot.assign(count, 0);
+    accel_stops.clear();
+    stats.accelerated_states = 0;
+    
+    for (size_t id = 1; id < count; id++) {
+        char stops[3];
+        size_t stop_count = 0;
+        bool loops = false;
+        for (int c = 0x20; c < 0x7f && stop_count <= 3; c++) {
+            if (next((uint16_t)id, (unsigned char)c) == id) {
+                loops = true;
+            } else if (stop_count < 3) {
+                stops[stop_count++] = (char)c;
+            } else {
+                stop_count++;
+            }
+        }
+        if (!loops || stop_count > 3 || accel_stops.size() >= 255) continue;
+        
+        if (stop_count == 0) stops[0] = 0x7f;    // DEL stops anyway
+        if (stop_count < 2) stops[1] = stops[0];
+        if (stop_count < 3) stops[2] = stops[1];
+        char passes[3] = {' ', ' ', ' '};
+        size_t pass_count = 0;
+        for (char c : {'\n', '\t', '\r'}) {
+            if (next((uint16_t)id, (unsigned char)c) == id) passes[pass_count++] = c;
+        }
+        bool high = true;
+        for (int c = 0x80; c < 0x100 && high; c++) {
+            high = next((uint16_t)id, (unsigned char)c) == id;
+        }
+        accel_stops.push_back(StopBytes(stops[0], stops[1], stops[2], passes[0], passes[1], passes[2], high));
+        accel_slot[id] = (uint8_t)accel_stops.size();
+        stats.accelerated_states++;
+    }
+}
+
+// Maximal munch only has to back up when an accepting state can be followed
+// by two or more non-accepting steps. For every accepting state, work out
+// the longest run of bytes the matcher may read past its lexeme before it
+// either accepts again or gets stuck: that is its lookahead. Non-accepting
+// states on a cycle make it unbounded.
+void DFA::analyseLookahead() {
+    size_t count = state_names.size();
+    const uint32_t UNBOUNDED = LOOKAHEAD_UNBOUNDED;
+    const uint32_t ON_PATH = 0xFFFFFFFF;
+    
+    // Bytes read from a non-accepting state up to and including the one that
+    // accepts or gets stuck; 0 until computed. Worked out by an iterative
+    // depth-first search so long chains of states cannot overflow the stack.
+    vector<uint32_t> run(count, 0);
+    auto extend = [&](uint32_t length) { return length >= UNBOUNDED ? UNBOUNDED : length + 1; };
+    auto runFrom = [&](uint16_t root) {
+        struct Frame { uint16_t state; int byte; uint32_t longest; };
+        vector<Frame> path(1, Frame{root, 0, 1});
+        run[root] = ON_PATH;
+        while (!path.empty()) {
+            Frame& frame = path.back();
+            if (frame.byte == 256) {
+                uint32_t length = frame.longest;
+                run[frame.state] = length;
+                path.pop_back();
+                if (!path.empty()) path.back().longest = max(path.back().longest, extend(length));
+                continue;
+            }
+            uint16_t target = next(frame.state, (unsigned char)frame.byte++);
+            if (target == ERROR_STATE || isAccepting(target)) {
+                continue;   // stuck or accepting after one byte
+            }
+            if (run[target] == ON_PATH) {
+                frame.longest = UNBOUNDED;
+            } else if (run[target] != 0) {
+                frame.longest = max(frame.longest, extend(run[target]));
+            } else {
+                run[target] = ON_PATH;
+                path.push_back(Frame{target, 0, 1});
+            }
+        }
+        return run[root];
+    };
+    
+    lookahead.assign(count, 0);
+    state_flags.assign(count, 0);
+    stats.terminal_states = stats.one_byte_states = stats.backtracking_states = 0;
+    for (size_t id = 1; id < count; id++) {
+        if (accel_slot[id] != 0) state_flags[id] |= STATE_ACCELERATED;
+        if (!isAccepting((uint16_t)id)) continue;
+        
+        uint32_t needed = 0;
+        for (int c = 0; c < 256; c++) {
+            uint16_t target = next((uint16_t)id, (unsigned char)c);
+            if (target == ERROR_STATE) continue;
+            uint32_t length = 1;
+            if (!isAccepting(target)) {
+                length = extend(run[target] != 0 ? run[target] : runFrom(target));
+            }
+            needed = max(needed, length);
+        }
+        // Only dead transitions: the lexeme is complete as soon as it is read
+        if (needed == 0) {
+            state_flags[id] |= STATE_TERMINAL;
+            stats.terminal_states++;
+        } else if (needed == 1) {
+            stats.one_byte_states++;
+        } else {
+            state_flags[id] |= STATE_BACKTRACK_POINT;
+            stats.backtracking_states++;
+        }
+        lookahead[id] = (uint8_t)needed;
+    }
+    backtrack_free = stats.backtracking_states == 0;
+}
+
+uint64_t DFA::fingerprint() const {
+    uint64_t h = hashBytes(class_of, sizeof(class_of));
+    h = hashBytes(&start_id, sizeof(start_id), h);
+    h = hashBytes(table.data(), table.size() * sizeof(uint16_t), h);
+    h = hashBytes(accept_bits.data(), accept_bits.size() * sizeof(uint64_t), h);
+    h = hashBytes(state_tags.data(), state_tags.size(), h);
+    for (const auto& word : reserved_words) {
+        uint8_t type = (uint8_t)word.second;
+        h = hashBytes(word.first.data(), word.first.size() + 1, h);
+        h = hashBytes(&type, 1, h);
+    }
+    return h;
+}
+
+void DFA::printStats(FILE* out) const {
+    fprintf(out, "DFA states: %zu before, %zu after (%zu unreachable, %zu dead removed)\n",
+            stats.states_before, stats.states_after, stats.unreachable_states, stats.dead_states);
+    fprintf(out, "Byte classes: %zu (table %zu bytes)\n",
+            stats.byte_classes, table.size() * sizeof(uint16_t));
+    fprintf(out, "Transitions: %zu duplicated, %zu conflicting\n",
+            stats.duplicate_transitions, stats.conflicting_transitions);
+    fprintf(out, "Accelerated states: %zu (%s scanner)\n", stats.accelerated_states, scanLevel());
+    fprintf(out, "Lookahead: %zu states commit at once, %zu peek one byte, %zu may backtrack\n",
+            stats.terminal_states, stats.one_byte_states, stats.backtracking_states);
+    for (size_t id = 1; id < state_names.size(); id++) {
+        if (isAccepting((uint16_t)id) && lookahead[id] > 1) {
+            if (lookahead[id] == LOOKAHEAD_UNBOUNDED) {
+                fprintf(out, "  %s: unbounded lookahead\n", state_names[id].c_str());
+            } else {
+                fprintf(out, "  %s: %u bytes of lookahead\n", state_names[id].c_str(), lookahead[id]);
+            }
+        }
+    }
+}
+
+// Binary rules format
+
+static const char COMPILED_DFA_MAGIC[8] = {'P', 'S', 'D', 'F', 'A', 'B', 'I', 'N'};
+
+struct CompiledHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t state_count;
+    uint32_t start_id;
+    uint32_t class_count;
+    uint64_t rules_size;
+    int64_t rules_mtime;    // nanoseconds
+    uint64_t payload_size;
+    uint64_t checksum;
+};
+
+static uint64_t fnv1a64(const char* data, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Size and mtime of the text rules, used to detect a stale binary
+static bool statRules(const string& rulesFile, uint64_t& size, int64_t& mtime) {
+    struct stat st;
+    if (rulesFile.empty() || stat(rulesFile.c_str(), &st) != 0) {
+        return false;
+    }
+    size = (uint64_t)st.st_size;
+    mtime = (int64_t)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+    return true;
+}
+
+static void putBytes(vector<char>& out, const void* data, size_t length) {
+    const char* bytes = (const char*)data;
+    out.insert(out.end(), bytes, bytes + length);
+}
+
+static void putString(vector<char>& out, const string& text) {
+    uint16_t length = (uint16_t)text.size();
+    putBytes(out, &length, sizeof(length));
+    putBytes(out, text.data(), text.size());
+}
+
+// Bounds-checked reader over the payload
+struct PayloadReader {
+    const char* pos;
+    const char* end;
+
+    bool take(void* out, size_t length) {
+        if ((size_t)(end - pos) < length) return false;
+        memcpy(out, pos, length);
+        pos += length;
+        return true;
+    }
+
+    bool takeString(string& out) {
+        uint16_t length;
+        if (!take(&length, sizeof(length)) || (size_t)(end - pos) < length) return false;
+        out.assign(pos, length);
+        pos += length;
+        return true;
+    }
+};
+
+bool DFA::saveCompiled(const string& filename, const string& rulesFile) const {
+    if (state_names.empty()) return false;
+
+    vector<char> payload;
+    putBytes(payload, class_of, sizeof(class_of));
+    putBytes(payload, table.data(), table.size() * sizeof(uint16_t));
+    putBytes(payload, accept_bits.data(), accept_bits.size() * sizeof(uint64_t));
+    vector<int8_t> tags(state_tags.begin(), state_tags.end());
+    tags.resize(state_names.size(), STATE_UNMAPPED);
+    putBytes(payload, tags.data(), tags.size());
+    for (const string& name : state_names) {
+        putString(payload, name);
+    }
+    uint32_t word_count = (uint32_t)reserved_words.size();
+    putBytes(payload, &word_count, sizeof(word_count));
+    for (const auto& word : reserved_words) {
+        uint8_t type = (uint8_t)word.second;
+        putBytes(payload, &type, sizeof(type));
+        putString(payload, word.first);
+    }
+
+    CompiledHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, COMPILED_DFA_MAGIC, sizeof(header.magic));
+    header.version = COMPILED_DFA_VERSION;
+    header.state_count = (uint32_t)state_names.size();
+    header.start_id = start_id;
+    header.class_count = class_count;
+    statRules(rulesFile, header.rules_size, header.rules_mtime);
+    header.payload_size = payload.size();
+    header.checksum = fnv1a64(payload.data(), payload.size());
+
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        perror("Error opening file");
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+    ok = (fclose(file) == 0) && ok;
+    return ok;
+}
+
+bool DFA::loadCompiled(const string& filename, const string& rulesFile) {
+    SourceBuffer buffer;
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0 || !buffer.loadFile(filename.c_str())) {
+        return false;
+    }
+    if (buffer.size() < sizeof(CompiledHeader)) return false;
+
+    CompiledHeader header;
+    memcpy(&header, buffer.begin(), sizeof(header));
+    if (memcmp(header.magic, COMPILED_DFA_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != COMPILED_DFA_VERSION ||
+        header.payload_size != buffer.size() - sizeof(header)) {
+        return false;
+    }
+
+    // A binary built from an older copy of the text rules is ignored
+    uint64_t rules_size;
+    int64_t rules_mtime;
+    if (statRules(rulesFile, rules_size, rules_mtime) &&
+        (rules_size != header.rules_size || rules_mtime != header.rules_mtime)) {
+        return false;
+    }
+
+    const char* payload = buffer.begin() + sizeof(header);
+    if (fnv1a64(payload, header.payload_size) != header.checksum) {
+        fprintf(stderr, "WARNING: Checksum mismatch in compiled rules %s\n", filename.c_str());
+        return false;
+    }
+
+    size_t count = header.state_count;
+    if (count == 0 || count > 0x10000 || header.start_id >= count ||
+        header.class_count == 0 || header.class_count > 256) {
+        return false;
+    }
+    uint16_t new_shift = 0;
+    while ((1u << new_shift) < header.class_count) new_shift++;
+
+    PayloadReader in = {payload, payload + header.payload_size};
+    uint8_t new_class_of[256];
+    pmr::vector<uint16_t> new_table(count << new_shift, table.get_allocator());
+    if (!in.take(new_class_of, sizeof(new_class_of))) return false;
+    for (uint8_t input_class : new_class_of) {
+        if (input_class >= header.class_count) return false;
+    }
+    pmr::vector<uint64_t> new_accept((count + 63) / 64, accept_bits.get_allocator());
+    pmr::vector<int8_t> new_tags(count, state_tags.get_allocator());
+    vector<string> new_names(count);
+    if (!in.take(new_table.data(), new_table.size() * sizeof(uint16_t)) ||
+        !in.take(new_accept.data(), new_accept.size() * sizeof(uint64_t)) ||
+        !in.take(new_tags.data(), new_tags.size())) {
+        return false;
+    }
+    for (string& name : new_names) {
+        if (!in.takeString(name)) return false;
+    }
+    for (uint16_t target : new_table) {
+        if (target >= count) return false;
+    }
+
+    uint32_t word_count;
+    if (!in.take(&word_count, sizeof(word_count))) return false;
+    vector<pair<string, Type>> new_words;
+    for (uint32_t i = 0; i < word_count; i++) {
+        uint8_t type;
+        string word;
+        if (!in.take(&type, sizeof(type)) || !in.takeString(word)) return false;
+        new_words.push_back(make_pair(word, (Type)type));
+    }
+
+    transitions.clear();
+    final_states.clear();
+    memcpy(class_of, new_class_of, sizeof(class_of));
+    class_count = (uint16_t)header.class_count;
+    class_shift = new_shift;
+    table.swap(new_table);
+    accept_bits.swap(new_accept);
+    state_tags.swap(new_tags);
+    state_names.swap(new_names);
+    reserved_words.swap(new_words);
+    state_ids.clear();
+    for (size_t id = 0; id < state_names.size(); id++) {
+        // Merged states carry all their original names separated by '|'
+        istringstream names(state_names[id]);
+        string name;
+        while (getline(names, name, '|')) {
+            state_ids[name] = (uint16_t)id;
+            if (isAccepting((uint16_t)id)) final_states.push_back(name);
+        }
+    }
+    start_id = (uint16_t)header.start_id;
+    start_state = state_names[start_id];
+    stats = DFAStats();
+    stats.states_before = stats.states_after = count - 1;
+    stats.byte_classes = class_count;
+    buildAccelerators();
+    analyseLookahead();
+    return true;
+}
+
+static bool hasCompiledMagic(const string& filename) {
+    char magic[sizeof(COMPILED_DFA_MAGIC)];
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == NULL) return false;
+    bool match = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                 memcmp(magic, COMPILED_DFA_MAGIC, sizeof(magic)) == 0;
+    fclose(file);
+    return match;
+}
+
+bool DFA::loadRules(const string& filename) {
+    if (hasCompiledMagic(filename)) {
+        return loadCompiled(filename, "");
+    }
+    if (loadCompiled(filename + ".bin", filename)) {
+        return true;
+    }
+    return loadDFAFromFile(filename);
 }
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+#include "include/diagnostics.h"
+#include "include/scan.h"
+
+using namespace std;
+
+void Diagnostics::add(DiagnosticKind kind, size_t offset, size_t length) {
+    if (offset > UINT32_MAX || length > UINT32_MAX - offset) {
+        throw length_error("diagnostic position beyond 4 GiB");
+    }
+    entries.push_back({kind, (uint32_t)offset, (uint32_t)length, 0, 0});
+    located = false;
+}
+
+void Diagnostics::locate(const char* source, size_t size) {
+    if (located) return;
+    stable_sort(entries.begin(), entries.end(),
+                [](const Diagnostic& a, const Diagnostic& b) { return a.offset < b.offset; });
+
+    // One pass over the text, jumping from newline to newline
+    const char* end = source + size;
+    const char* lineStart = source;
+    uint32_t line = 1;
+    for (Diagnostic& entry : entries) {
+        const char* at = source + entry.offset;
+        for (;;) {
+            const char* newline = findByte(lineStart, end, '\n');
+            if (newline >= at) break;
+            lineStart = newline + 1;
+            line++;
+        }
+        entry.line = line;
+        entry.column = (uint32_t)(at - lineStart) + 1;
+    }
+    located = true;
+}
+
+string printableByte(char c) {
+    char text[8];
+    unsigned char byte = (unsigned char)c;
+    if (byte >= 0x20 && byte < 0x7f) {
+        snprintf(text, sizeof(text), "%c", c);
+    } else {
+        snprintf(text, sizeof(text), "\\x%02x", byte);
+    }
+    return text;
+}
+
+string Diagnostic::message(const char* source) const {
+    char text[160];
+    int n;
+    switch (kind) {
+        case UNRECOGNIZED_CHARACTER:
+            n = snprintf(text, sizeof(text), "ERROR: Unrecognized character '%s'",
+                         printableByte(source[offset]).c_str());
+            break;
+        case UNTERMINATED_LITERAL:
+            n = snprintf(text, sizeof(text), "ERROR: Unterminated literal");
+            break;
+        case UNTERMINATED_COMMENT:
+            n = snprintf(text, sizeof(text), "ERROR: Unterminated comment");
+            break;
+        case UNMATCHED_BRACE:
+            n = snprintf(text, sizeof(text), "ERROR: Unexpected closing brace '}' - no matching opening brace");
+            break;
+        default:
+            n = snprintf(text, sizeof(text), "ERROR: Unknown DFA state");
+            break;
+    }
+    snprintf(text + n, sizeof(text) - n, " at line %u, column %u (position %u)", line, column, offset);
+    return text;
+}
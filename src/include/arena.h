@@ -0,0 +1,104 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <ostream>
+
+using namespace std;
+
+// Memory resources for the lexer's allocations. The Lexer (its compiled
+// DFA tables), TokenCursor and TokenStream take a pmr::memory_resource,
+// so a host can route, cap or measure them:
+//
+//   CountingResource counted;                   // measure the default heap
+//   LexArena arena(64 * 1024, &counted);        // one arena per thread
+//   for (each file) {
+//       TokenStream tokens = lexer.lex(source, nullptr, nullptr, &arena);
+//       ...
+//       arena.reset();                          // before the next file
+//   }
+//
+// For long-lived mixed allocations std::pmr::synchronized_pool_resource
+// works as well. Only the DFA tables and the token storage (columns,
+// literals, cursor lookahead and scratch) go through the resource, so only
+// they are counted or kept in an arena. Everything else stays on the
+// global heap: rule parsing scratch, the file contents, the SymbolTable,
+// Diagnostics, OutputBuffer and the per-file results of batch mode.
+
+// Monotonic bump allocator whose memory is kept across reset(). After
+// the first files it has grown to fit the largest, and storing the tokens
+// of further files makes no upstream calls. Deallocation is a no-op. One arena per
+// thread: it is not synchronised.
+class LexArena : public pmr::memory_resource {
+private:
+    struct Block {
+        Block* next;
+        size_t size;        // usable bytes after the header
+    };
+
+    pmr::memory_resource* upstream;
+    Block* blocks = nullptr;    // newest first
+    char* pos = nullptr;
+    char* end = nullptr;
+    size_t nextSize;
+
+    void addBlock(size_t atLeast);
+    void releaseBlocks();
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    explicit LexArena(size_t initialSize = 64 * 1024, pmr::memory_resource* upstream = pmr::get_default_resource());
+    ~LexArena();
+    LexArena(const LexArena&) = delete;
+    LexArena& operator=(const LexArena&) = delete;
+
+    // Forget every allocation. Blocks are kept; several are merged into one
+    // block of their total size, so the next round fits without growing.
+    void reset();
+
+    size_t capacity() const;
+};
+
+// Allocation counters of a CountingResource at one moment
+struct MemoryUsage {
+    size_t allocated = 0;       // bytes ever allocated
+    size_t allocations = 0;
+    size_t current = 0;         // bytes allocated and not yet freed
+    size_t peak = 0;            // highest current since the last resetPeak
+};
+
+// Forwards to an upstream resource and counts what passes through.
+// Thread-safe.
+class CountingResource : public pmr::memory_resource {
+private:
+    pmr::memory_resource* upstream;
+    atomic<size_t> allocated{0};
+    atomic<size_t> allocations{0};
+    atomic<size_t> current{0};
+    atomic<size_t> peak{0};
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    explicit CountingResource(pmr::memory_resource* upstream = pmr::new_delete_resource()) : upstream(upstream) {}
+
+    MemoryUsage usage() const;
+
+    // Start a new phase: the peak restarts from the current use
+    void resetPeak() { peak.store(current.load()); }
+};
+
+// One line of a --mem-stats report: what a phase allocated, from the
+// usage before it and at its end
+void printMemoryPhase(ostream& out, const char* phase, const MemoryUsage& before, const MemoryUsage& after);
+
+#endif // ARENA_H
@@ -0,0 +1,34 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <string>
+#include <vector>
+#include "arena.h"
+#include "lexer.h"
+#include "output.h"
+#include "token_cache.h"
+
+using namespace std;
+
+struct BatchOptions {
+    OutputFormat format = TEXT_FORMAT;
+    size_t threads = 1;
+    bool recover = false;     // keep lexing a file after errors, see Diagnostics
+    TokenCache* cache = nullptr;  // skip lexing files whose tokens are cached
+    size_t readAhead = 8;     // files read ahead of the lexing threads, 0 to read in each task
+    CountingResource* memory = nullptr;  // upstream of the per-task arenas, reported when set
+};
+
+// Expand files and directories (recursively, *.pas files) into a sorted list
+bool collectInputs(const vector<string>& paths, vector<string>& files);
+
+// Lex files on a work-stealing pool sharing one Lexer. Files are read by a
+// ReadAhead stage while earlier ones are lexed. Output of each file is
+// buffered and written in input order, followed by throughput totals.
+// Tokens and cursor buffers come from an arena per running task, reset
+// between files. A file with a lexical error fails without stopping the
+// run; unless options.recover, its tokens end at the first error.
+// Returns the process exit code.
+int runBatch(const Lexer& lexer, const vector<string>& files, const BatchOptions& options);
+
+#endif // BATCH_H
@@ -0,0 +1,37 @@
+#ifndef CHUNKED_LEXER_H
+#define CHUNKED_LEXER_H
+
+#include <cstddef>
+#include "lexer.h"
+#include "source.h"
+#include "token_stream.h"
+
+using namespace std;
+
+// Chunks smaller than this are not worth a thread of their own. Splitting
+// also ends at the first lexical error, with -r too: lexChunked stops there
+// and the rest of the source, however large, is lexed on one thread.
+const size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+// Lex one large source in DFA mode on up to `chunks` threads.
+//
+// Every chunk but the first starts at a guessed token boundary (the next
+// line start) and is lexed speculatively. A chunk whose guess ends in an
+// error is retried as if it had started inside a comment or a literal.
+// The chunks are then stitched in order: from the true end of the previous
+// chunk the lexer runs sequentially until it reaches a lexeme start the
+// speculative pass also saw, and from there adopts the chunk's tokens.
+// Lexing is deterministic from any lexeme start, so the result equals the
+// sequential one.
+//
+// Tokens are appended to `tokens`. Returns the offset at which lexing
+// stopped: source.size() when done, otherwise the start of a lexeme that
+// does not match. Lexing sequentially from there reports the error the
+// way readTokenDFA does.
+//
+// With symbols, identifiers of the stitched tokens are interned there on the
+// calling thread in source order, so their ids match the sequential lexer's.
+size_t lexChunked(const Lexer& lexer, const SourceBuffer& source, size_t chunks, TokenStream& tokens,
+                  SymbolTable* symbols = nullptr);
+
+#endif // CHUNKED_LEXER_H
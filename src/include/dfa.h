@@ -2,28 +2,158 @@
 #define DFA_H
 
 #include <map>
+#include <memory_resource>
 #include <string>
 #include <fstream>
 #include <vector>
+#include <cstdint>
+#include <cstdio>
+#include "token.h"
+#include "scan.h"
 
 using namespace std;
 
+// Markers stored in the per-state tag table next to real Type values
+enum StateTag {
+    STATE_UNMAPPED = -1,
+    STATE_COMMENT = -2,
+    STATE_NO_MATCH = -3     // matcher result when no prefix is accepted; never stored
+};
+
+// Compiled rules file layout (all integers little-endian):
+//   header  magic "PSDFABIN", version, state count, start id, text rules
+//           size and mtime, payload size, FNV-1a 64 checksum of the payload
+//   payload [state][256] uint16 table, accept bitmap words, per-state tags,
+//           state names, reserved words
+const uint32_t COMPILED_DFA_VERSION = 2;
+
+// What the loader did to the rules, reported by printStats
+struct DFAStats {
+    size_t states_before = 0;
+    size_t states_after = 0;
+    size_t unreachable_states = 0;
+    size_t dead_states = 0;
+    size_t byte_classes = 0;
+    size_t duplicate_transitions = 0;
+    size_t conflicting_transitions = 0;
+    size_t accelerated_states = 0;
+    size_t terminal_states = 0;         // accepting states that commit without lookahead
+    size_t one_byte_states = 0;         // accepting states that peek one byte
+    size_t backtracking_states = 0;     // accepting states that may read further and back up
+};
+
 class DFA {
 private:
     map<pair<string, char>, string> transitions;
     string start_state;
     vector<string> final_states;
-    
-public:    
+    vector<pair<string, Type>> reserved_words;     // extra words declared by the rules
+
+    map<string, int8_t> tag_names;  // token tag per state name, used when minimising
+    int current_line = 0;
+    DFAStats stats;
+
+    // Compiled form, built by compile() once the rules are loaded.
+    // Merged states are named "A|B" and every original name maps to them.
+    // The tables the matcher reads come from the DFA's memory resource.
+    vector<string> state_names;
+    map<string, uint16_t> state_ids;
+    uint8_t class_of[256] = {};     // byte -> equivalence class
+    uint16_t class_count = 0;
+    uint16_t class_shift = 0;       // row stride is 1 << class_shift
+    pmr::vector<uint16_t> table;        // [state][class] next-state ids
+    pmr::vector<uint64_t> accept_bits;  // one bit per state
+    pmr::vector<int8_t> state_tags;     // token Type or StateTag per state
+    uint16_t start_id = ERROR_STATE;
+    pmr::vector<uint8_t> accel_slot;    // 1-based index into accel_stops, 0 if none
+    pmr::vector<StopBytes> accel_stops; // bytes that leave a self-looping state
+    pmr::vector<uint8_t> lookahead;     // per accepting state, see analyseLookahead
+    pmr::vector<uint8_t> state_flags;   // STATE_ACCELERATED | STATE_TERMINAL | STATE_BACKTRACK_POINT
+    bool backtrack_free = false;
+
+    uint16_t internState(const string& state);
+    bool compile();
+    void buildAccelerators();
+    void analyseLookahead();
+
+public:
+    // State id 0 is the dead state; every missing transition leads to it
+    static constexpr uint16_t ERROR_STATE = 0;
+
+    // Matcher loop flags per state
+    static constexpr uint8_t STATE_ACCELERATED = 1;
+    static constexpr uint8_t STATE_TERMINAL = 2;    // accepting, every transition is dead
+    static constexpr uint8_t STATE_BACKTRACK_POINT = 4;     // accepting, lookahead of 2 or more
+
+    // Lookahead of a state whose lexeme can be followed by an unbounded
+    // run of non-accepting states (or 255 bytes or more of them)
+    static constexpr uint8_t LOOKAHEAD_UNBOUNDED = 255;
+
+    explicit DFA(pmr::memory_resource* memory = pmr::get_default_resource());
+
     void addTransition(const string& from_state, char input, const string& to_state);
     void setStartState(const string& state);
     void addFinalState(const string& state);
-    
+    void addReservedWord(const string& word, Type type);
+    void addUtf8Transitions(const string& from_state, const string& to_state);
+
+    // String-keyed view, kept for debugging and tooling
     string getNextState(const string& current_state, char input) const;
     string getStartState() const;
     bool isFinalState(const string& state) const;
-    
+
     bool loadDFAFromFile(const string& filename);
+
+    // Binary form written by --compile-rules
+    bool saveCompiled(const string& filename, const string& rulesFile) const;
+    bool loadCompiled(const string& filename, const string& rulesFile);
+
+    // Prefer a fresh "<rules>.bin" next to the rules file, else parse the text
+    bool loadRules(const string& filename);
+
+    // Compiled view used by the lexer hot path
+    uint16_t getStartId() const { return start_id; }
+    uint16_t next(uint16_t state, unsigned char input) const {
+        return table[((size_t)state << class_shift) | class_of[input]];
+    }
+    bool isAccepting(uint16_t state) const {
+        return (accept_bits[state >> 6] >> (state & 63)) & 1;
+    }
+    // Self-looping states whose run can be skipped in one scan
+    bool isAccelerated(uint16_t state) const { return accel_slot[state] != 0; }
+    const char* skipLoop(uint16_t state, const char* p, const char* end) const {
+        return findStop(accel_stops[accel_slot[state] - 1], p, end);
+    }
+    uint8_t getFlags(uint16_t state) const { return state_flags[state]; }
+    // Bytes an accepting state may read past its lexeme before the token is
+    // certain: 0 for terminal states, 1 when the next byte either extends
+    // the match into another accepting state or ends it
+    uint8_t getLookahead(uint16_t state) const { return lookahead[state]; }
+    // No accepting state needs more than one byte of lookahead, so a match
+    // never has to back up to an earlier accepting position
+    bool isBacktrackFree() const { return backtrack_free; }
+    const StopBytes* getLoopStops(uint16_t state) const {
+        return accel_slot[state] != 0 ? &accel_stops[accel_slot[state] - 1] : nullptr;
+    }
+    size_t getStateCount() const { return state_names.size(); }
+    const string& getStateName(uint16_t state) const { return state_names[state]; }
+    int getStateId(const string& state) const;
+    bool hasStateTags() const { return !state_tags.empty(); }
+    int getStateTag(uint16_t state) const { return state_tags[state]; }
+    size_t getClassCount() const { return class_count; }
+    uint8_t getClassOf(unsigned char input) const { return class_of[input]; }
+
+    // Token tags by state name; must be set before loading so that
+    // minimisation only merges accepting states producing the same token
+    void setStateTagNames(const map<string, int8_t>& tags) { tag_names = tags; }
+
+    // Hash of the compiled tables and reserved words: equal for rules that
+    // lex identically, whichever file or format they were loaded from
+    uint64_t fingerprint() const;
+
+    const DFAStats& getStats() const { return stats; }
+    void printStats(FILE* out) const;
+    const vector<pair<string, Type>>& getReservedWords() const { return reserved_words; }
 };
 
-#endif // DFA_H
\ No newline at end of file
+#endif // DFA_H
@@ -0,0 +1,58 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum DiagnosticKind {
+    UNRECOGNIZED_CHARACTER,
+    UNTERMINATED_LITERAL,
+    UNTERMINATED_COMMENT,
+    UNMATCHED_BRACE,
+    UNKNOWN_STATE
+};
+
+// One lexical error; its bytes became an ERROR_TOKEN
+struct Diagnostic {
+    DiagnosticKind kind;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t line;      // 1-based, filled in by Diagnostics::locate
+    uint32_t column;    // 1-based, in bytes
+
+    // "ERROR: Unterminated literal at line 3, column 9 (position 41)"
+    string message(const char* source) const;
+};
+
+// Lexical errors of one run, collected instead of printed so that lexing
+// can go on. Line and column are only worked out when asked for.
+class Diagnostics {
+private:
+    vector<Diagnostic> entries;
+    bool located;
+
+public:
+    Diagnostics() : located(true) {}
+
+    // Throws length_error past 4 GiB, which loaded sources never reach
+    void add(DiagnosticKind kind, size_t offset, size_t length);
+
+    // Fill in line and column of every entry from the source text
+    void locate(const char* source, size_t size);
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    const Diagnostic& operator[](size_t index) const { return entries[index]; }
+    vector<Diagnostic>::const_iterator begin() const { return entries.begin(); }
+    vector<Diagnostic>::const_iterator end() const { return entries.end(); }
+    void clear() { entries.clear(); located = true; }
+};
+
+// c itself when it is printable ASCII, else "\xNN", for error messages
+string printableByte(char c);
+
+#endif // DIAGNOSTICS_H
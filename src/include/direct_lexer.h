@@ -0,0 +1,27 @@
+#ifndef DIRECT_LEXER_H
+#define DIRECT_LEXER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "dfa.h"
+#include "keywords.h"
+
+using namespace std;
+
+// Implemented by src/generated/direct_lexer.cpp, which make writes from
+// the rules file with tools/gen_direct_lexer.cpp.
+
+// Longest match starting at p, with the same contract as the interpreted
+// DFA: returns the token tag (Type or STATE_COMMENT) of the last accepting
+// state, or STATE_NO_MATCH; lastFinalPos is where that lexeme ends and
+// stop is the byte the automaton got stuck on, or end.
+int directMatch(const char* p, const char* end, const char*& lastFinalPos, const char*& stop);
+
+// Reserved words declared by the rules file the code was generated from
+extern const ReservedWord DIRECT_RESERVED_WORDS[];
+extern const size_t DIRECT_RESERVED_WORD_COUNT;
+extern const char* const DIRECT_RULES_FILE;
+// DFA::fingerprint() of those rules
+extern const uint64_t DIRECT_RULES_FINGERPRINT;
+
+#endif // DIRECT_LEXER_H
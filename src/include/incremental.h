@@ -0,0 +1,120 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "diagnostics.h"
+#include "lexer.h"
+#include "token.h"
+#include "token_stream.h"
+
+using namespace std;
+
+// Replace `removed` bytes at `offset` by `inserted` new ones
+struct TextEdit {
+    size_t offset;
+    size_t removed;
+    size_t inserted;
+};
+
+// Tokens per block of an IncrementalLexer
+const size_t INCREMENTAL_BLOCK_TOKENS = 512;
+
+// Token list of a document that is edited in place, for editor integrations.
+// After an edit only the tokens whose lexing looked at the edited bytes are
+// re-lexed: lexing restarts at the end of the last unaffected token and stops
+// as soon as a new token starts where an old one did, past the edit, since
+// from any lexeme start the rest of the input lexes the same way.
+//
+// Tokens live in blocks whose offsets are relative to the block base. An
+// edit rewrites the blocks it touches; the blocks after it keep their tokens
+// and are moved by a pending delta, folded into their bases only when a later
+// edit needs it. Needs a lexer in DFA or direct mode. Lexical errors are
+// recovered from as in recover mode: they become ERROR_TOKENs, listed by
+// diagnostics(), so every text has the token list of a full lex.
+class IncrementalLexer {
+private:
+    struct Entry {
+        uint32_t offset;        // relative to the block base
+        uint32_t length;
+        uint32_t lookahead;     // bytes past the lexeme the automaton read
+        uint32_t literal;       // index into Block::literals, or NO_LITERAL
+        uint8_t type;
+        uint8_t error;          // DiagnosticKind of an ERROR_TOKEN
+    };
+
+    struct Block {
+        uint32_t base;
+        vector<Entry> tokens;
+        vector<string> literals;
+    };
+
+    // Token position as (block, index in block)
+    struct Position {
+        size_t block;
+        size_t index;
+    };
+
+    const Lexer& lexer;
+    string_view text;
+    vector<unique_ptr<Block>> blocks;
+    size_t pendingFrom;         // blocks from here on are shifted by pendingDelta
+    int64_t pendingDelta;
+    size_t count;
+    uint32_t maxLookahead;
+    size_t relexed;
+    Diagnostics scanErrors;     // filled by scan, one error at a time
+
+    uint32_t baseOf(size_t block) const {
+        return (uint32_t)(blocks[block]->base + (block >= pendingFrom ? pendingDelta : 0));
+    }
+    uint32_t startOf(Position at) const { return baseOf(at.block) + blocks[at.block]->tokens[at.index].offset; }
+    bool atEnd(Position at) const { return at.block >= blocks.size(); }
+    Position next(Position at) const;
+
+    Position firstAffected(size_t offset) const;
+    bool scan(SourceCursor& in, Entry& entry, string& literal);
+    void copyToken(vector<unique_ptr<Block>>& out, Position at, int64_t shift) const;
+    static void appendToken(vector<unique_ptr<Block>>& out, Entry entry, const string* literal);
+    void shiftBlocks(size_t from, size_t to, int64_t delta);
+
+public:
+    explicit IncrementalLexer(const Lexer& lexer);
+
+    // Lex text from scratch. The caller keeps text alive and unchanged
+    // until the next reset or edit.
+    void reset(string_view text);
+
+    // text is the whole document after the edit
+    void applyEdit(string_view text, const TextEdit& edit);
+
+    size_t size() const { return count; }
+    size_t lastRelexed() const { return relexed; }     // tokens lexed by the last call
+
+    // Lexical errors of the current text, one per ERROR_TOKEN, in order
+    Diagnostics diagnostics() const;
+
+    // Copy of the current tokens, text included
+    TokenStream toStream() const;
+
+    class const_iterator {
+    private:
+        const IncrementalLexer* owner;
+        Position at;
+    public:
+        const_iterator(const IncrementalLexer* owner, Position at) : owner(owner), at(at) {}
+        TokenView operator*() const;
+        const_iterator& operator++() { at = owner->next(at); return *this; }
+        bool operator!=(const const_iterator& other) const { return at.block != other.at.block || at.index != other.at.index; }
+        bool operator==(const const_iterator& other) const { return !(*this != other); }
+    };
+
+    const_iterator begin() const { return const_iterator(this, {0, 0}); }
+    const_iterator end() const { return const_iterator(this, {blocks.size(), 0}); }
+};
+
+#endif // INCREMENTAL_H
@@ -0,0 +1,120 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "token.h"
+
+using namespace std;
+
+// Built-in Pascal-S reserved words, including the word-shaped operators
+struct ReservedWord {
+    const char* text;
+    Type type;
+};
+
+constexpr ReservedWord BUILTIN_RESERVED_WORDS[] = {
+    {"program", KEYWORD}, {"var", KEYWORD}, {"procedure", KEYWORD},
+    {"begin", KEYWORD}, {"end", KEYWORD}, {"if", KEYWORD}, {"then", KEYWORD},
+    {"else", KEYWORD}, {"while", KEYWORD}, {"do", KEYWORD}, {"for", KEYWORD},
+    {"to", KEYWORD}, {"downto", KEYWORD}, {"integer", KEYWORD}, {"real", KEYWORD},
+    {"boolean", KEYWORD}, {"char", KEYWORD}, {"array", KEYWORD}, {"of", KEYWORD},
+    {"function", KEYWORD}, {"const", KEYWORD}, {"type", KEYWORD},
+    {"and", LOGICAL_OPERATOR}, {"or", LOGICAL_OPERATOR}, {"not", LOGICAL_OPERATOR},
+    {"div", ARITHMETIC_OPERATOR}, {"mod", ARITHMETIC_OPERATOR}
+};
+
+const size_t MAX_KEYWORD_LENGTH = 15;
+const size_t KEYWORD_TABLE_SIZE = 64;
+
+// Hash over the length and three sampled bytes, so a probe costs O(1)
+constexpr uint32_t keywordHash(uint32_t seed, const char* text, size_t length) {
+    uint32_t h = (seed ^ (uint32_t)length) * 0x01000193u;
+    h = (h ^ (unsigned char)text[0]) * 0x01000193u;
+    h = (h ^ (unsigned char)text[length / 2]) * 0x01000193u;
+    h = (h ^ (unsigned char)text[length - 1]) * 0x01000193u;
+    return h ^ (h >> 15);
+}
+
+constexpr size_t constexprLength(const char* text) {
+    size_t length = 0;
+    while (text[length] != '\0') length++;
+    return length;
+}
+
+struct KeywordSlot {
+    char text[MAX_KEYWORD_LENGTH + 1];
+    uint8_t length;     // 0 marks an empty slot
+    uint8_t type;
+};
+
+constexpr bool isCollisionFree(uint32_t seed) {
+    bool used[KEYWORD_TABLE_SIZE] = {};
+    for (const ReservedWord& word : BUILTIN_RESERVED_WORDS) {
+        size_t slot = keywordHash(seed, word.text, constexprLength(word.text)) & (KEYWORD_TABLE_SIZE - 1);
+        if (used[slot]) return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+constexpr uint32_t findKeywordSeed() {
+    for (uint32_t seed = 0; seed < 100000; seed++) {
+        if (isCollisionFree(seed)) return seed;
+    }
+    return 0xFFFFFFFF;
+}
+
+constexpr uint32_t KEYWORD_SEED = findKeywordSeed();
+static_assert(KEYWORD_SEED != 0xFFFFFFFF, "no perfect hash seed for the reserved words");
+
+constexpr array<KeywordSlot, KEYWORD_TABLE_SIZE> buildKeywordTable() {
+    array<KeywordSlot, KEYWORD_TABLE_SIZE> table = {};
+    for (const ReservedWord& word : BUILTIN_RESERVED_WORDS) {
+        size_t length = constexprLength(word.text);
+        KeywordSlot& slot = table[keywordHash(KEYWORD_SEED, word.text, length) & (KEYWORD_TABLE_SIZE - 1)];
+        for (size_t i = 0; i < length; i++) slot.text[i] = word.text[i];
+        slot.length = (uint8_t)length;
+        slot.type = (uint8_t)word.type;
+    }
+    return table;
+}
+
+constexpr array<KeywordSlot, KEYWORD_TABLE_SIZE> BUILTIN_KEYWORD_TABLE = buildKeywordTable();
+
+// Reserved-word lookup: one probe into the compile-time table, plus an
+// open-addressing table for words added by the rules file
+class KeywordTable {
+private:
+    struct ExtraWord {
+        string text;
+        Type type;
+    };
+    vector<ExtraWord> extraWords;
+    vector<int32_t> extraSlots;     // index into extraWords, -1 if empty
+
+    bool lookupExtra(string_view word, Type& type) const;
+
+public:
+    void add(const string& word, Type type);
+    size_t extraCount() const { return extraWords.size(); }
+
+    // Sets type and returns true if word is reserved
+    bool lookup(string_view word, Type& type) const {
+        size_t length = word.size();
+        if (length - 1 < MAX_KEYWORD_LENGTH) {
+            const KeywordSlot& slot = BUILTIN_KEYWORD_TABLE[keywordHash(KEYWORD_SEED, word.data(), length) & (KEYWORD_TABLE_SIZE - 1)];
+            if (slot.length == length && memcmp(slot.text, word.data(), length) == 0) {
+                type = (Type)slot.type;
+                return true;
+            }
+        }
+        return !extraWords.empty() && length > 0 && lookupExtra(word, type);
+    }
+};
+
+#endif // KEYWORDS_H
@@ -3,48 +3,171 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstdio>
 #include <map>
+#include <deque>
+#include <memory_resource>
 #include "token.h"
 #include "dfa.h"
+#include "keywords.h"
+#include "source.h"
+#include "token_stream.h"
+#include "diagnostics.h"
+#include "symbol_table.h"
+#include "profile.h"
 
 using namespace std;
 
 enum LexerMode {
     DFA_MODE,
-    SWITCH_MODE
+    SWITCH_MODE,
+    DIRECT_MODE         // code generated from the rules at build time
 };
 
+// Outcome of Lexer::scanLexeme
+enum ScanResult {
+    SCAN_TOKEN,         // token filled in
+    SCAN_COMMENT,       // a comment was skipped, token holds only its span
+    SCAN_END,           // end of input
+    SCAN_ERROR          // no lexeme matches, cursor left at its start
+};
+
+class TokenCursor;
+class TokenCache;
+
+// Once constructed a Lexer is immutable: all reading state lives in the
+// SourceCursor/TokenCursor, so one Lexer can be shared by many threads.
 class Lexer {
 private:
     LexerMode mode;
     DFA dfa;
-    map<string, Type> stateToTokenType;
+    KeywordTable keywords;
     
     // Common helper methods
-    bool isPascalKeyword(const string& word);
-    bool isLogicalOperator(const string& word);
-    bool isArithmeticOperator(const string& word);
-    void skipWhitespace(FILE* file);
-    void skipBraceComment(FILE* file);
-    void skipParenComment(FILE* file);
+    void skipWhitespace(SourceCursor& in) const;
+    bool skipBraceComment(SourceCursor& in) const;
+    bool skipParenComment(SourceCursor& in) const;
     
     // Switch-based lexer methods
-    Token* readTokenSwitch(FILE* file);
+    bool readTokenSwitch(SourceCursor& in, TokenView& token) const;
     
     // DFA-based lexer methods
     void initializeStateMapping();
-    Token* createToken(const string& state, const string& value);
-    Token* readTokenDFA(FILE* file);
+    void initializeKeywords();
+    bool createToken(int tag, SourceCursor& in, const char* start, TokenView& token) const;
+    // PROFILE instantiations count into in.profile, the others never look at it
+    template <bool PROFILE>
+    uint16_t matchDFA(const SourceCursor& in, const char*& lastFinalPos, const char*& stop) const;
+    template <bool PROFILE>
+    int matchLexeme(const SourceCursor& in, const char*& lastFinalPos, const char*& stop) const;
+    template <bool PROFILE>
+    bool readTokenDFA(SourceCursor& in, TokenView& token) const;
     
 public:
-    Lexer(LexerMode mode = DFA_MODE, const string& dfaRulesFile = "rules/pascal_lexicon.dfa");
-    Token* readToken(FILE* file);
-    vector<Token*> lex(FILE* file);
+    // The compiled DFA tables are allocated from memory
+    Lexer(LexerMode mode = DFA_MODE, const string& dfaRulesFile = "rules/pascal_lexicon.dfa",
+          pmr::memory_resource* memory = pmr::get_default_resource());
+    // Take rules already loaded with the lexicon's state tags, such as a
+    // snapshot built and validated by ReloadableLexer
+    Lexer(LexerMode mode, DFA&& rules);
+    bool readToken(SourceCursor& in, TokenView& token) const;
+    
+    // Next token of the input, skipping whitespace and comments; false at the end
+    bool nextToken(SourceCursor& in, TokenView& token) const;
+    
+    // DFA and direct mode only: skip whitespace and match one lexeme, reporting
+    // errors to the caller instead of exiting. Used for speculative and
+    // incremental lexing. With in.diagnostics, a lexeme that does not match
+    // is recovered from as readToken does and comes back as an ERROR_TOKEN;
+    // without, the result is SCAN_ERROR. If given, stop receives the byte the
+    // automaton got stuck on (or the end, or the lexeme end when nothing can
+    // follow it): the lexeme depends on everything up to there.
+    ScanResult scanLexeme(SourceCursor& in, TokenView& token, const char** stop = nullptr) const;
+    
+    // Lazily produce tokens of source starting at offset from; the source
+    // must outlive the cursor. With diagnostics, lexical errors are recorded
+    // there and come out as ERROR_TOKENs; without, they are fatal. With
+    // symbols, identifiers are interned there and carry their symbol id.
+    // The cursor's buffers are allocated from memory.
+    TokenCursor tokens(const SourceBuffer& source, size_t from = 0, Diagnostics* diagnostics = nullptr,
+                       SymbolTable* symbols = nullptr,
+                       pmr::memory_resource* memory = pmr::get_default_resource()) const;
+    
+    // Collect every token of source into a stream allocated from memory
+    TokenStream lex(const SourceBuffer& source, Diagnostics* diagnostics = nullptr,
+                    SymbolTable* symbols = nullptr,
+                    pmr::memory_resource* memory = pmr::get_default_resource()) const;
+    TokenStream lex(FILE* file) const;
+    
+    const DFA& getDFA() const { return dfa; }
+    
+    LexerMode getMode() const { return mode; }
+    
+    // Identifies the tokens this lexer produces: its mode and compiled rules
+    uint64_t fingerprint() const;
+    
+    // Write the loaded rules in the binary format for faster startup
+    bool compileRules(const string& outputFile, const string& rulesFile) const;
+};
+
+// Pull-based token reader over one source. A token's text stays valid until
+// the next call to next(); tokens returned by peek() stay valid until consumed.
+//
+//   for (TokenView token : lexer.tokens(source)) { ... }
+class TokenCursor {
+private:
+    struct Pending {
+        TokenView token;
+        string text;        // owned copy when the text was not a source view
+        bool ownsText;
+    };
+
+    const Lexer* lexer;
+    SourceCursor in;
+    pmr::deque<Pending> lookahead;
+    string current;         // storage for the token last returned from lookahead
+
+    bool fill(size_t count);
+
+public:
+    TokenCursor(const Lexer& lexer, const SourceBuffer& source, size_t from = 0,
+                Diagnostics* diagnostics = nullptr, SymbolTable* symbols = nullptr,
+                pmr::memory_resource* memory = pmr::get_default_resource());
+
+    bool next(TokenView& token);
+    const TokenView* peek(size_t k = 0);
+    long offset() const { return in.offset(); }
+    void setProfile(LexProfile* profile) { in.profile = profile; }
+
+    class iterator {
+    private:
+        TokenCursor* cursor;
+        TokenView token;
+        bool done;
+    public:
+        explicit iterator(TokenCursor* cursor) : cursor(cursor), token(), done(cursor == nullptr) {
+            if (!done) done = !cursor->next(token);
+        }
+        const TokenView& operator*() const { return token; }
+        const TokenView* operator->() const { return &token; }
+        iterator& operator++() {
+            done = !cursor->next(token);
+            return *this;
+        }
+        bool operator!=(const iterator& other) const { return done != other.done; }
+        bool operator==(const iterator& other) const { return done == other.done; }
+    };
+
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(nullptr); }
 };
 
 // Utility functions
 FILE* read_file(const char* filename);
-vector<Token*> lex_file(const char* filename, LexerMode mode = DFA_MODE);
+bool read_file(const char* filename, SourceBuffer& source);
+// With a cache, unchanged files are not lexed again, see TokenCache
+TokenStream lex_file(const char* filename, LexerMode mode = DFA_MODE, TokenCache* cache = nullptr);
+TokenStream lex_file(const SourceBuffer& source, LexerMode mode = DFA_MODE, TokenCache* cache = nullptr);
 
 #endif // LEXER_H
\ No newline at end of file
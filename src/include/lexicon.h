@@ -0,0 +1,16 @@
+#ifndef LEXICON_H
+#define LEXICON_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include "token.h"
+
+using namespace std;
+
+// Token produced by each accepting state name of the Pascal-S rules: a
+// Type value, or STATE_COMMENT for states whose lexeme is skipped.
+// Shared by the Lexer and the direct-coded lexer generator.
+map<string, int8_t> lexiconStateTags();
+
+#endif // LEXICON_H
@@ -0,0 +1,146 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include "token.h"
+
+using namespace std;
+
+enum OutputFormat {
+    TEXT_FORMAT,        // TYPE(value) per line, the classic output
+    JSONL_FORMAT,       // one JSON object per line
+    BINARY_FORMAT,      // record stream, see BinaryTokenWriter
+    COUNT_FORMAT        // nothing per token, only the count
+};
+
+bool parseOutputFormat(const string& name, OutputFormat& format);
+
+// Size at which an OutputBuffer hands its contents to write(2)
+const size_t OUTPUT_BATCH_SIZE = 256 * 1024;
+
+// Append-only byte buffer drained to a file descriptor in large batches.
+// With fd < 0 nothing is written and the buffer just grows, which is how
+// output is collected in memory. The first failed write (EPIPE, ENOSPC...)
+// is kept in writeError(), and later output is dropped.
+class OutputBuffer {
+private:
+    int fd;
+    char* data;
+    size_t size;
+    size_t capacity;
+    int error;          // errno of the first failed write, 0 if none
+
+    void reserve(size_t needed);
+    void writeAll(const char* bytes, size_t length);
+
+public:
+    explicit OutputBuffer(int fd = -1, size_t capacity = OUTPUT_BATCH_SIZE);
+    ~OutputBuffer();
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    void append(const char* bytes, size_t length) {
+        if (size + length > capacity) {
+            makeRoom(length);
+            if (fd >= 0 && length > capacity) {
+                writeAll(bytes, length);
+                return;
+            }
+        }
+        memcpy(data + size, bytes, length);
+        size += length;
+    }
+    void append(char c) {
+        if (size == capacity) makeRoom(1);
+        data[size++] = c;
+    }
+    void makeRoom(size_t length);
+
+    void flush();
+    void clear() { size = 0; }
+    bool inMemory() const { return fd < 0; }
+    int writeError() const { return error; }
+
+    // Overwrite bytes already appended; only for in-memory buffers
+    void patch(size_t at, const void* bytes, size_t length) { memcpy(data + at, bytes, length); }
+    const char* contents() const { return data; }
+    size_t length() const { return size; }
+};
+
+// Flush cout; if it or out dropped output, say why on stderr and return true
+bool outputFailed(const OutputBuffer& out);
+
+// Formats tokens into an OutputBuffer
+class TokenWriter {
+protected:
+    OutputBuffer& out;
+    size_t count;
+
+public:
+    explicit TokenWriter(OutputBuffer& out) : out(out), count(0) {}
+    virtual ~TokenWriter() {}
+
+    virtual void write(const TokenView& token) = 0;
+    virtual void finish() {}
+    // Source text the token offsets refer to, for formats that report code points
+    virtual void setSource(const char*) {}
+    size_t getCount() const { return count; }
+};
+
+class TextTokenWriter : public TokenWriter {
+public:
+    explicit TextTokenWriter(OutputBuffer& out) : TokenWriter(out) {}
+    void write(const TokenView& token) override;
+};
+
+// With a source set, tokens also get "cp_offset" and "cp_length" in UTF-8
+// code points. Tokens arrive in order, so the count only moves forward.
+class JsonlTokenWriter : public TokenWriter {
+private:
+    const char* source;
+    uint32_t bytesSeen;
+    uint32_t codePointsSeen;
+
+public:
+    explicit JsonlTokenWriter(OutputBuffer& out)
+        : TokenWriter(out), source(nullptr), bytesSeen(0), codePointsSeen(0) {}
+    void write(const TokenView& token) override;
+    void setSource(const char* text) override {
+        source = text;
+        bytesSeen = codePointsSeen = 0;
+    }
+};
+
+// Header: magic "PSTOKENS", uint32 version, uint32 record count (0 when
+// streamed straight to a file descriptor, since it is not known up front).
+// Record: uint32 offset, uint32 length, uint32 value length, uint8 type,
+// 3 padding bytes, then the value padded to a multiple of 4, so every
+// record starts 4-byte aligned in an mmap'ed file.
+const uint32_t BINARY_TOKENS_VERSION = 1;
+
+class BinaryTokenWriter : public TokenWriter {
+private:
+    size_t headerAt;
+
+public:
+    explicit BinaryTokenWriter(OutputBuffer& out);
+    void write(const TokenView& token) override;
+    void finish() override;
+};
+
+class CountTokenWriter : public TokenWriter {
+public:
+    explicit CountTokenWriter(OutputBuffer& out) : TokenWriter(out) {}
+    void write(const TokenView&) override { count++; }
+};
+
+unique_ptr<TokenWriter> createTokenWriter(OutputFormat format, OutputBuffer& out);
+
+// text as a quoted JSON string; malformed UTF-8 becomes U+FFFD
+void appendJsonString(OutputBuffer& out, string_view text);
+
+#endif // OUTPUT_H
@@ -0,0 +1,41 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "token.h"
+
+using namespace std;
+
+class DFA;
+
+// Counters filled by the lexer when a cursor has a profile attached (see
+// --profile). The lexer checks for one once per token and runs a separately
+// instantiated matcher when it is set, so unprofiled lexing pays nothing.
+struct LexProfile {
+    size_t states = 0;
+    vector<uint64_t> stateVisits;       // bytes consumed in each DFA state
+    vector<uint64_t> transitions;       // [from * states + to]
+    uint64_t lexemes = 0;               // DFA runs, comments included
+    uint64_t backtracks = 0;            // runs that read past the accepted prefix
+    uint64_t rescannedBytes = 0;        // bytes read past it, lexed again later
+    uint64_t commentBytes = 0;
+    uint64_t literalBytes = 0;
+    uint64_t tokens[ERROR_TOKEN + 1] = {};
+
+    // Phase timings, filled in by the driver
+    double loadSeconds = 0;
+    double lexSeconds = 0;
+    double outputSeconds = 0;
+
+    // Size the per-state counters for dfa; without one only the totals count
+    void reset(const DFA* dfa);
+
+    void countToken(Type type) { tokens[type]++; }
+
+    void print(FILE* out, const DFA* dfa) const;
+};
+
+#endif // PROFILE_H
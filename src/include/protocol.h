@@ -0,0 +1,88 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+
+// Lex server protocol, the same over a Unix socket and over stdin/stdout.
+// Every message is a frame: uint32 payload length, then the payload. All
+// integers are little-endian.
+//
+//   request   uint8 kind, then a file path (LEX_PATH) or the source text
+//             itself (LEX_SOURCE)
+//   response  uint8 status, uint32 token bytes, the tokens in the server's
+//             --format, then diagnostics as text lines up to the frame end
+//
+// A connection carries any number of requests, answered in order.
+enum LexRequestKind : uint8_t {
+    LEX_PATH = 'P',
+    LEX_SOURCE = 'S'
+};
+
+enum LexStatus : uint8_t {
+    LEX_OK = 0,
+    LEX_ERRORS = 1,         // tokens include ERROR_TOKENs, see the diagnostics
+    LEX_FAILED = 2          // file could not be read or request was malformed
+};
+
+// Frames larger than this are refused, by the server and the client alike
+const uint32_t MAX_FRAME_SIZE = 1u << 26;
+
+inline void putUint32(unsigned char* at, uint32_t value) {
+    at[0] = (unsigned char)value;
+    at[1] = (unsigned char)(value >> 8);
+    at[2] = (unsigned char)(value >> 16);
+    at[3] = (unsigned char)(value >> 24);
+}
+
+inline uint32_t getUint32(const unsigned char* at) {
+    return at[0] | at[1] << 8 | at[2] << 16 | (uint32_t)at[3] << 24;
+}
+
+// Both false at end of stream or on an error other than EINTR
+inline bool readFully(int fd, void* data, size_t length) {
+    char* at = (char*)data;
+    while (length > 0) {
+        ssize_t n = read(fd, at, length);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        at += n;
+        length -= (size_t)n;
+    }
+    return true;
+}
+
+inline bool writeFully(int fd, const void* data, size_t length) {
+    const char* at = (const char*)data;
+    while (length > 0) {
+        ssize_t n = write(fd, at, length);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        at += n;
+        length -= (size_t)n;
+    }
+    return true;
+}
+
+// False at end of stream or on a bad frame
+inline bool readFrame(int fd, string& payload) {
+    unsigned char header[4];
+    if (!readFully(fd, header, sizeof(header))) return false;
+    uint32_t length = getUint32(header);
+    if (length > MAX_FRAME_SIZE) return false;
+    payload.resize(length);
+    return readFully(fd, &payload[0], length);
+}
+
+inline bool writeFrame(int fd, const char* payload, size_t length) {
+    unsigned char header[4];
+    putUint32(header, (uint32_t)length);
+    return writeFully(fd, header, sizeof(header)) && writeFully(fd, payload, length);
+}
+
+#endif // PROTOCOL_H
@@ -0,0 +1,91 @@
+#ifndef READ_AHEAD_H
+#define READ_AHEAD_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// A file read by ReadAhead, valid until it is released
+struct PrefetchedFile {
+    size_t index = 0;           // position in the file list
+    const char* data = "";      // NUL-terminated, like a SourceBuffer
+    size_t size = 0;
+    bool ok = false;            // false if the file could not be opened or read
+    int error = 0;              // errno of the failure when not ok
+};
+
+// Reads a list of files on an I/O thread ahead of the threads lexing them,
+// so reading one file overlaps lexing the ones before it. Files are handed
+// out in list order. The read-ahead window is bounded: at most depth
+// files, and at most budget bytes unless a single file is larger, are
+// read but not yet released. Their buffers are pooled and reused; the pool
+// also stays within budget bytes, so one huge file does not pin its
+// buffer for the rest of the run. With
+// io_uring every read of the window is in flight at once; where io_uring
+// is unavailable the I/O thread reads one file at a time.
+class ReadAhead {
+private:
+    struct Buffer {
+        unique_ptr<char[]> bytes;
+        size_t capacity = 0;
+    };
+
+    enum State { WAITING, READY, FAILED };
+
+    struct Entry {
+        Buffer buffer;
+        size_t size = 0;
+        size_t reserved = 0;    // bytes counted in heldBytes
+        bool counted = false;   // admitted into the window
+        State state = WAITING;
+        int error = 0;          // errno when FAILED
+    };
+
+    struct Ring;                // io_uring instance, see read_ahead.cpp
+
+    const vector<string>& files;
+    size_t depth;
+    size_t budget;
+    unique_ptr<Ring> ring;      // null when io_uring is unavailable
+
+    mutex lock;
+    condition_variable entryReady;      // an entry left WAITING
+    condition_variable windowFreed;     // a file was released or reading stops
+    vector<Entry> entries;
+    vector<Buffer> freeBuffers;
+    size_t freeBytes = 0;       // capacity of freeBuffers
+    size_t taken = 0;
+    size_t held = 0;            // files started and not yet released
+    size_t heldBytes = 0;
+    bool stopping = false;
+    thread worker;
+
+    bool admit(size_t index, size_t size, bool wait);
+    Buffer acquireBuffer(size_t size);
+    void recycle(Buffer&& buffer);
+    bool readPlain(int fd, size_t expected, Buffer& buffer, size_t& length);
+    void finish(size_t index, Buffer&& buffer, size_t size, int error);
+    void readLoop(size_t first);
+    void uringLoop();
+
+public:
+    ReadAhead(const vector<string>& files, size_t depth = 8, size_t budget = 64u << 20);
+    ~ReadAhead();
+
+    // Next file in list order, waiting for its read; false once all were taken
+    bool take(PrefetchedFile& file);
+
+    // Hand the buffer of a taken file back to the pool
+    void release(const PrefetchedFile& file);
+
+    // "io_uring" or "read"
+    const char* backend() const { return ring ? "io_uring" : "read"; }
+};
+
+#endif // READ_AHEAD_H
@@ -0,0 +1,85 @@
+#ifndef RELOADABLE_LEXER_H
+#define RELOADABLE_LEXER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "lexer.h"
+
+using namespace std;
+
+// The current rule set of a long-running process. Every rule set is an
+// immutable, reference-counted Lexer snapshot. reload() builds and
+// validates the next one on the calling thread and publishes it with one
+// atomic pointer store; lexes already running keep the snapshot they hold.
+// Readers go through a LexerSnapshot, which only takes the lock when a
+// new rule set has been published since its last look.
+class ReloadableLexer {
+private:
+    LexerMode mode;             // as requested; reloads build this mode
+    string rulesFile;
+
+    mutable mutex lock;                 // guards current, serialises reloads
+    shared_ptr<const Lexer> current;
+    atomic<const Lexer*> published;     // current.get(), readable without the lock
+
+public:
+    // The first snapshot is built like a plain Lexer, falling back to
+    // switch mode if the rules cannot be loaded
+    ReloadableLexer(LexerMode mode, const string& rulesFile);
+
+    // Build a snapshot from the rules file and publish it. If the file is
+    // missing or invalid the current snapshot stays and error says why.
+    bool reload(string& error);
+
+    shared_ptr<const Lexer> snapshot() const;
+    const Lexer* latest() const { return published.load(memory_order_acquire); }
+
+    // Mode of the published Lexer: switch after a fallback, until a
+    // reload loads the rules
+    LexerMode getMode() const { return latest()->getMode(); }
+    const string& getRulesFile() const { return rulesFile; }
+};
+
+// One reader's hold on a rule set, e.g. one per worker or connection.
+// get() costs one atomic load while the rule set is unchanged.
+class LexerSnapshot {
+private:
+    const ReloadableLexer& rules;
+    shared_ptr<const Lexer> held;
+
+public:
+    explicit LexerSnapshot(const ReloadableLexer& rules) : rules(rules), held(rules.snapshot()) {}
+
+    // The newest rule set; the previous one is released once nothing else holds it
+    const Lexer& get() {
+        if (rules.latest() != held.get()) {
+            held = rules.snapshot();
+        }
+        return *held;
+    }
+};
+
+// Reload rules when the rules file (or its compiled .bin) is rewritten or
+// renamed into place, watched with inotify, or when the process gets
+// SIGHUP. Runs on a thread of its own; one watcher per process.
+class RulesWatcher {
+private:
+    ReloadableLexer& rules;
+    int wakeup[2] = {-1, -1};       // self-pipe: SIGHUP and stop() write here
+    int inotifyFd = -1;
+    thread worker;
+
+    void watchLoop();
+
+public:
+    explicit RulesWatcher(ReloadableLexer& rules);
+    ~RulesWatcher();
+
+    void start();
+    void stop();
+};
+
+#endif // RELOADABLE_LEXER_H
@@ -0,0 +1,51 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// Bytes that end a run: up to three printable terminators (unused slots
+// repeat the first one), DEL, every control byte but up to three passed
+// ones (such as '\n'; unused slots hold ' '), and bytes >= 0x80 unless
+// passHigh is set. Callers must look at the byte they stopped on.
+struct StopBytes {
+    char bytes[3];
+    char passes[3];
+    bool passHigh;
+
+    StopBytes() : bytes{0, 0, 0}, passes{' ', ' ', ' '}, passHigh(false) {}
+    StopBytes(char a) : bytes{a, a, a}, passes{' ', ' ', ' '}, passHigh(false) {}
+    StopBytes(char a, char b) : bytes{a, b, b}, passes{' ', ' ', ' '}, passHigh(false) {}
+    StopBytes(char a, char b, char c) : bytes{a, b, c}, passes{' ', ' ', ' '}, passHigh(false) {}
+    StopBytes(char a, char b, char c, char passA, char passB, char passC, bool passHigh)
+        : bytes{a, b, c}, passes{passA, passB, passC}, passHigh(passHigh) {}
+};
+
+// Run scanners, vectorised with SSE2 or AVX2 when the CPU has them.
+// All of them return end when nothing is found.
+
+// First byte that is not ' ', '\t', '\n' or '\r'
+const char* skipSpaces(const char* p, const char* end);
+
+// First byte that stops, see StopBytes
+const char* findStop(const StopBytes& stops, const char* p, const char* end);
+
+// First occurrence of c
+const char* findByte(const char* p, const char* end, char c);
+
+// Number of UTF-8 code points: every byte that is not a continuation byte
+size_t countCodePoints(const char* p, const char* end);
+
+// Length of the well-formed UTF-8 sequence starting at p, or 0 if it is
+// malformed, overlong, a surrogate or beyond U+10FFFF
+size_t utf8SequenceLength(const char* p, const char* end);
+
+// 64-bit hash of a byte range, for content addressing; not cryptographic
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+// Instruction set picked at startup: "avx2", "sse2" or "scalar"
+const char* scanLevel();
+
+#endif // SCAN_H
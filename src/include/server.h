@@ -0,0 +1,30 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <cstddef>
+#include <string>
+#include "lexer.h"
+#include "reloadable_lexer.h"
+#include "output.h"
+#include "protocol.h"
+
+using namespace std;
+
+struct ServerOptions {
+    OutputFormat format = TEXT_FORMAT;
+    size_t threads = 1;
+    string socketPath;      // empty: one client on stdin/stdout
+    int output = STDOUT_FILENO;     // where stdin/stdout mode writes responses
+};
+
+// Keep one warmed Lexer resident and answer lex requests until the input
+// ends (stdin/stdout) or SIGINT or SIGTERM arrives (socket), which closes
+// the socket and every connection. Each socket client has a thread for its
+// I/O, up to a fixed number of clients; its requests are lexed on a fixed
+// pool of worker threads. Lexical errors never stop the
+// server: they come back as diagnostics. Except in direct mode, the rules
+// are reloaded when their file changes or on SIGHUP. Returns the process
+// exit code.
+int runServer(ReloadableLexer& rules, const ServerOptions& options);
+
+#endif // SERVER_H
@@ -0,0 +1,73 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <memory_resource>
+#include <string>
+
+using namespace std;
+
+// Files at least this large are mmap'ed instead of read into the heap
+const size_t MMAP_THRESHOLD = 1 << 20;
+
+// Token offsets and lengths are 32-bit, so longer sources are refused
+const size_t MAX_SOURCE_SIZE = 0xFFFFFFFF;
+
+// Whole source text held in one contiguous range
+class SourceBuffer {
+private:
+    const char* data;
+    size_t length;
+    char* owned;        // heap copy, freed on destruction
+    void* mapped;       // mmap'ed file, unmapped on destruction
+
+    void release();
+
+public:
+    SourceBuffer();
+    SourceBuffer(const char* data, size_t length);   // borrowed, caller keeps it alive
+    ~SourceBuffer();
+
+    SourceBuffer(SourceBuffer&& other);
+    SourceBuffer& operator=(SourceBuffer&& other);
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    // Both fail with errno EFBIG for sources over MAX_SOURCE_SIZE
+    bool loadFile(const char* filename);
+    bool loadStream(FILE* file);
+
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+    size_t size() const { return length; }
+};
+
+class Diagnostics;
+class SymbolTable;
+struct LexProfile;
+
+// Read position over a SourceBuffer; backtracking just moves pos
+struct SourceCursor {
+    const char* begin;
+    const char* pos;
+    const char* end;
+    pmr::string scratch;    // holds unescaped literal text for the current token
+    Diagnostics* diagnostics;   // errors are recorded here if set, else fatal
+    SymbolTable* symbols;       // identifiers are interned here if set
+    LexProfile* profile;        // DFA and direct mode count into this if set
+
+    explicit SourceCursor(const SourceBuffer& source, size_t from = 0,
+                          pmr::memory_resource* memory = pmr::get_default_resource())
+        : begin(source.begin()), pos(source.begin() + from), end(source.end()), scratch(memory),
+          diagnostics(nullptr), symbols(nullptr), profile(nullptr) {}
+
+    bool atEnd() const { return pos >= end; }
+    long offset() const { return (long)(pos - begin); }
+
+    // fgetc/ungetc style helpers for the switch lexer
+    int get() { return pos < end ? (unsigned char)*pos++ : EOF; }
+    void unget() { pos--; }
+};
+
+#endif // SOURCE_H
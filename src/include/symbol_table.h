@@ -0,0 +1,60 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// Interned identifier names, safe to fill from several threads at once.
+// Equal names get equal 32-bit ids, so later stages compare names as
+// integers. The table is split into shards picked by the hash, each with
+// its own lock, open-addressing index and text arena, so threads only
+// contend when they insert into the same shard at once. Interned text is
+// never moved: views returned by name() stay valid until clear().
+class SymbolTable {
+private:
+    static const uint32_t SHARD_BITS = 6;
+    static const uint32_t SHARD_COUNT = 1u << SHARD_BITS;
+    static const size_t ARENA_BLOCK_SIZE = 64 * 1024;
+    static const size_t MAX_SHARD_ENTRIES = (size_t)1 << (32 - SHARD_BITS);
+
+    struct Slot {
+        uint32_t hash;
+        uint32_t entry;     // index into entries plus one, 0 marks an empty slot
+    };
+
+    struct Shard {
+        mutable mutex lock;
+        vector<Slot> slots;             // power-of-two size, at most half full
+        vector<string_view> entries;    // text by local index
+        vector<unique_ptr<char[]>> blocks;
+        char* tail = nullptr;           // unused end of the newest block
+        size_t tailSize = 0;
+
+        const char* store(string_view text);
+        void rehash(size_t size);
+    };
+
+    Shard shards[SHARD_COUNT];
+
+public:
+    // Id of text, adding it if it is new. Throws length_error once a shard
+    // holds more names than its ids can number.
+    uint32_t intern(string_view text);
+
+    // Add every name of other, which is not being changed meanwhile
+    void internAll(const SymbolTable& other);
+
+    // Name of a symbol id returned by intern
+    string_view name(uint32_t symbol) const;
+
+    size_t size() const;
+    void clear();
+};
+
+#endif // SYMBOL_TABLE_H
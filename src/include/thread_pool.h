@@ -0,0 +1,50 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Fixed-size pool where every worker owns a task deque. A worker takes
+// its newest task first and, when its own deque is empty, steals the
+// oldest task of another worker.
+class WorkStealingPool {
+private:
+    struct TaskQueue {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+
+    vector<unique_ptr<TaskQueue>> queues;
+    vector<thread> workers;
+    atomic<size_t> queued;          // tasks waiting in any deque
+    atomic<size_t> unfinished;      // tasks submitted but not yet done
+    atomic<size_t> nextQueue;
+    bool stopping;
+
+    mutex stateLock;
+    condition_variable workAvailable;
+    condition_variable allDone;
+
+    bool tryTake(size_t self, function<void()>& task);
+    void workerLoop(size_t self);
+
+public:
+    explicit WorkStealingPool(size_t threads);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(function<void()> task);
+    void wait();
+    size_t size() const { return workers.size(); }
+};
+
+#endif // THREAD_POOL_H
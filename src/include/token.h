@@ -2,6 +2,8 @@
 #define TOKEN_H
 
 #include <string>
+#include <string_view>
+#include <cstdint>
 
 using namespace std;
 
@@ -23,9 +25,15 @@ enum Type {
     RPARENTHESIS,
     LBRACKET,
     RBRACKET,
-    RANGE_OPERATOR
+    RANGE_OPERATOR,
+    ERROR_TOKEN         // bytes of a lexical error, when recovering from errors
 };
 
+const char* typeToString(Type type);
+
+// Symbol id of tokens that are not interned identifiers, see SymbolTable
+const uint32_t NO_SYMBOL = 0xFFFFFFFF;
+
 class Token {
 private:
     Type type;
@@ -38,4 +46,18 @@ public:
     string getTypeName() const;
 };
 
+// Non-owning token handed out by the lexer and by TokenStream.
+// text is the token value: the lexeme itself, or the unescaped body of a literal.
+struct TokenView {
+    Type type;
+    string_view text;
+    uint32_t offset;    // lexeme position in the source
+    uint32_t length;    // lexeme length in the source
+    uint32_t symbol;    // interned name of an identifier, or NO_SYMBOL
+
+    string toString() const;
+    string getValue() const;
+    string getTypeName() const;
+};
+
 #endif // TOKEN_H
\ No newline at end of file
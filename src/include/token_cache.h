@@ -0,0 +1,69 @@
+#ifndef TOKEN_CACHE_H
+#define TOKEN_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include "lexer.h"
+
+using namespace std;
+
+// On-disk cache of lexed files, addressed by a hash of the source text and
+// Lexer::fingerprint(), so an edited file or changed rules simply miss.
+// Each entry is one file in the cache directory:
+//
+//   header    magic, both hashes, source size, token count, arena size
+//   image     the TokenStream columns and literal arena, see
+//             TokenStream::writeImage
+//
+// A hit maps the entry privately and the returned stream serves its tokens
+// from the mapping; only the bounds of each token are checked, nothing is
+// decoded or copied. Entries are in host byte order and written to a
+// temporary name and renamed, so concurrent processes may share a
+// directory. When the directory grows past its limit the least recently
+// used entries (oldest mtime; hits touch it) are removed. Only files that
+// lexed without errors are stored. All methods are thread-safe.
+class TokenCache {
+private:
+    string directory;
+    uint64_t maxBytes;
+
+    mutex lock;                 // guards usedBytes and eviction
+    uint64_t usedBytes = 0;
+
+    atomic<size_t> hits{0};
+    atomic<size_t> misses{0};
+    atomic<size_t> stores{0};
+    atomic<size_t> evictions{0};
+
+    string entryPath(uint64_t contentHash, uint64_t rulesHash) const;
+    bool load(const string& path, uint64_t contentHash, uint64_t rulesHash, const SourceBuffer& source,
+              TokenStream& tokens, SymbolTable* symbols, pmr::memory_resource* memory);
+    void store(const string& path, uint64_t contentHash, uint64_t rulesHash, const SourceBuffer& source,
+               const TokenStream& tokens);
+    void evict();
+
+public:
+    static const uint64_t DEFAULT_MAX_BYTES = 256ull << 20;
+
+    TokenCache(const string& directory, uint64_t maxBytes = DEFAULT_MAX_BYTES);
+
+    // Create the directory if needed, measure what it already holds and
+    // evict down to maxBytes if it is over
+    bool open();
+
+    // Tokens of source as lexer would produce them, from the cache when an
+    // entry matches, else lexed and stored. Arguments are as for Lexer::lex.
+    TokenStream lex(const Lexer& lexer, const SourceBuffer& source, Diagnostics* diagnostics = nullptr,
+                    SymbolTable* symbols = nullptr,
+                    pmr::memory_resource* memory = pmr::get_default_resource());
+
+    size_t getHits() const { return hits.load(); }
+    size_t getMisses() const { return misses.load(); }
+    void printStats(ostream& out) const;
+};
+
+#endif // TOKEN_CACHE_H
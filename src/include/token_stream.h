@@ -0,0 +1,112 @@
+#ifndef TOKEN_STREAM_H
+#define TOKEN_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include "token.h"
+#include "source.h"
+
+using namespace std;
+
+const uint32_t NO_LITERAL = 0xFFFFFFFF;
+
+// Compact token list stored as parallel arrays in a single allocation.
+// Token text is a view into the source, except for literals whose unescaped
+// body differs from the lexeme; those are copied once into a side arena.
+// Offsets are 32-bit, so one stream covers sources up to 4 GiB; larger
+// ones are refused when loaded, see MAX_SOURCE_SIZE. Both
+// allocations come from the stream's memory resource, unless the stream
+// serves an image from a mapped file (see adoptImage).
+class TokenStream {
+private:
+    const char* source;     // text the offsets point into
+    SourceBuffer ownedSource;
+    pmr::memory_resource* memory;
+
+    void* block;            // backing storage for the arrays below
+    uint32_t* offsets;
+    uint32_t* lengths;
+    uint32_t* literals;     // arena offset of unescaped text, or NO_LITERAL
+    uint32_t* symbols;      // interned identifier id, or NO_SYMBOL
+    uint8_t* types;
+    size_t count;
+    size_t capacity;
+
+    char* arena;            // [uint32 length][bytes] records
+    size_t arenaSize;
+    size_t arenaCapacity;   // 0 while the arena is in the mapping
+
+    void* mapping;          // adopted image, unmapped on destruction
+    size_t mappingSize;
+
+    void grow();
+    void releaseStorage();
+    uint32_t storeLiteral(string_view text);
+    string_view lexemeText(size_t index) const;
+
+public:
+    explicit TokenStream(pmr::memory_resource* memory = pmr::get_default_resource());
+    explicit TokenStream(const char* source, pmr::memory_resource* memory = pmr::get_default_resource());
+    ~TokenStream();
+
+    TokenStream(TokenStream&& other);
+    TokenStream& operator=(TokenStream&& other);
+    TokenStream(const TokenStream&) = delete;
+    TokenStream& operator=(const TokenStream&) = delete;
+
+    // Keep the source alive for as long as the stream refers to it
+    void adoptSource(SourceBuffer&& buffer);
+    void setSource(const char* text) { source = text; }
+    const char* getSource() const { return source; }
+
+    void push(const TokenView& token);
+    void reserve(size_t tokens);
+    void clear();
+
+    // The columns and the arena as one image, how TokenCache stores them:
+    // offsets, lengths, literals, symbols (all NO_SYMBOL) and types of
+    // every token, padded to a multiple of 4 bytes, then the arena records
+    static size_t imageSize(size_t tokens, size_t arenaBytes);
+    size_t imageSize() const { return imageSize(count, arenaSize); }
+    size_t literalBytes() const { return arenaSize; }
+    void writeImage(char* out) const;
+
+    // Serve tokens from an image at imageAt (a multiple of 4) inside a
+    // private writable mmap, which the stream unmaps when done. Nothing is
+    // copied until the stream grows. False if a token lies outside a
+    // source of sourceSize bytes or a literal outside the arena.
+    bool adoptImage(void* mapping, size_t mappingSize, size_t imageAt, size_t tokens, size_t arenaBytes,
+                    size_t sourceSize);
+    void setSymbol(size_t index, uint32_t symbol) { symbols[index] = symbol; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Type getType(size_t index) const { return (Type)types[index]; }
+    uint32_t getOffset(size_t index) const { return offsets[index]; }
+    uint32_t getLength(size_t index) const { return lengths[index]; }
+    uint32_t getSymbol(size_t index) const { return symbols[index]; }
+    // Text stored in the arena rather than viewed in the source
+    bool hasLiteral(size_t index) const { return literals[index] != NO_LITERAL; }
+    string_view getText(size_t index) const;
+    TokenView operator[](size_t index) const;
+
+    class const_iterator {
+    private:
+        const TokenStream* stream;
+        size_t index;
+    public:
+        const_iterator(const TokenStream* stream, size_t index) : stream(stream), index(index) {}
+        TokenView operator*() const { return (*stream)[index]; }
+        const_iterator& operator++() { index++; return *this; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+};
+
+#endif // TOKEN_STREAM_H
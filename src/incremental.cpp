@@ -0,0 +1,321 @@
+#include <algorithm>
+
+#include "include/incremental.h"
+
+using namespace std;
+
+static bool isLiteralType(Type type) {
+    return type == CHAR_LITERAL || type == STRING_LITERAL;
+}
+
+// Text a token has when none was stored: the lexeme, minus quotes for literals
+static string_view lexemeText(string_view text, Type type, uint32_t offset, uint32_t length) {
+    if (isLiteralType(type) && length >= 2) {
+        return text.substr(offset + 1, length - 2);
+    }
+    return text.substr(offset, length);
+}
+
+IncrementalLexer::IncrementalLexer(const Lexer& lexer)
+    : lexer(lexer), pendingFrom(0), pendingDelta(0), count(0), maxLookahead(0), relexed(0) {}
+
+IncrementalLexer::Position IncrementalLexer::next(Position at) const {
+    if (++at.index >= blocks[at.block]->tokens.size()) {
+        at.block++;
+        at.index = 0;
+    }
+    return at;
+}
+
+// Next token from the cursor with an absolute offset; false at the end.
+// Comments are skipped. Lexical errors come back as ERROR_TOKENs, as in
+// recover mode. The lookahead covers the skipped comments too, so a token
+// is re-lexed whenever anything read since the previous token changes.
+bool IncrementalLexer::scan(SourceCursor& in, Entry& entry, string& literal) {
+    TokenView token;
+    const char* stop;
+    const char* reach = in.pos;
+    in.diagnostics = &scanErrors;
+    for (;;) {
+        ScanResult result = lexer.scanLexeme(in, token, &stop);
+        if (result == SCAN_END || result == SCAN_ERROR) {
+            return false;
+        }
+        reach = max(reach, stop);
+        if (result == SCAN_TOKEN) {
+            break;
+        }
+    }
+
+    const char* tokenEnd = in.begin + token.offset + token.length;
+    entry.error = 0;
+    if (token.type == ERROR_TOKEN && !scanErrors.empty()) {
+        // Where recovery resumes depends on the byte there as well
+        entry.error = (uint8_t)scanErrors[scanErrors.size() - 1].kind;
+        scanErrors.clear();
+        reach = max(reach, min(tokenEnd + 1, in.end));
+    }
+    entry.offset = token.offset;
+    entry.length = token.length;
+    entry.lookahead = reach > tokenEnd ? (uint32_t)(reach - tokenEnd) : 0;
+    entry.type = (uint8_t)token.type;
+    entry.literal = NO_LITERAL;
+    maxLookahead = max(maxLookahead, entry.lookahead);
+
+    string_view plain = lexemeText(text, token.type, token.offset, token.length);
+    if (token.text.data() != plain.data() || token.text.size() != plain.size()) {
+        literal.assign(token.text.data(), token.text.size());
+        entry.literal = 0;
+    }
+    return true;
+}
+
+// Add a token with an absolute offset to the last block, starting a new
+// block when it is full
+void IncrementalLexer::appendToken(vector<unique_ptr<Block>>& out, Entry entry, const string* literal) {
+    if (out.empty() || out.back()->tokens.size() >= INCREMENTAL_BLOCK_TOKENS) {
+        out.emplace_back(new Block());
+        out.back()->base = entry.offset;
+    }
+    Block& block = *out.back();
+    entry.offset -= block.base;
+    entry.literal = NO_LITERAL;
+    if (literal != nullptr) {
+        entry.literal = (uint32_t)block.literals.size();
+        block.literals.push_back(*literal);
+    }
+    block.tokens.push_back(entry);
+}
+
+void IncrementalLexer::copyToken(vector<unique_ptr<Block>>& out, Position at, int64_t shift) const {
+    const Block& block = *blocks[at.block];
+    Entry entry = block.tokens[at.index];
+    entry.offset = (uint32_t)(startOf(at) + shift);
+    appendToken(out, entry, entry.literal == NO_LITERAL ? nullptr : &block.literals[entry.literal]);
+}
+
+void IncrementalLexer::shiftBlocks(size_t from, size_t to, int64_t delta) {
+    for (size_t i = from; i < to; i++) {
+        blocks[i]->base = (uint32_t)(blocks[i]->base + delta);
+    }
+}
+
+void IncrementalLexer::reset(string_view newText) {
+    text = newText;
+    blocks.clear();
+    pendingFrom = 0;
+    pendingDelta = 0;
+    count = 0;
+    maxLookahead = 0;
+
+    SourceBuffer buffer(text.data(), text.size());
+    SourceCursor in(buffer);
+    Entry entry;
+    string literal;
+    while (scan(in, entry, literal)) {
+        appendToken(blocks, entry, entry.literal == NO_LITERAL ? nullptr : &literal);
+        count++;
+    }
+    relexed = count;
+}
+
+// First token whose lexing read a byte at or after offset. Only the last
+// maxLookahead bytes before offset need to be looked at.
+IncrementalLexer::Position IncrementalLexer::firstAffected(size_t offset) const {
+    // First block starting at or after offset
+    size_t low = 0, high = blocks.size();
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (baseOf(mid) < offset) low = mid + 1;
+        else high = mid;
+    }
+    if (low == 0) {
+        return {0, 0};
+    }
+
+    // First token of the block before it that starts at or after offset;
+    // every token from there on is affected
+    size_t block = low - 1;
+    const vector<Entry>& tokens = blocks[block]->tokens;
+    uint32_t relative = (uint32_t)(offset - baseOf(block));
+    size_t index = lower_bound(tokens.begin(), tokens.end(), relative,
+                               [](const Entry& entry, uint32_t value) { return entry.offset < value; }) - tokens.begin();
+    Position first = {block, index};
+
+    // Earlier tokens are affected if their lookahead reaches offset
+    while (block > 0 || index > 0) {
+        if (index == 0) {
+            block--;
+            index = blocks[block]->tokens.size();
+        }
+        index--;
+        const Entry& entry = blocks[block]->tokens[index];
+        size_t end = baseOf(block) + entry.offset + entry.length;
+        if (end + maxLookahead < offset) {
+            break;
+        }
+        if (end + entry.lookahead >= offset) {
+            first = {block, index};
+        }
+    }
+    return first;
+}
+
+void IncrementalLexer::applyEdit(string_view newText, const TextEdit& edit) {
+    if (blocks.empty()) {
+        reset(newText);
+        return;
+    }
+    text = newText;
+    int64_t delta = (int64_t)edit.inserted - (int64_t)edit.removed;
+    size_t editEnd = edit.offset + edit.inserted;
+
+    // Resume at the end of the last token the edit cannot have changed
+    Position first = firstAffected(edit.offset);
+    if (atEnd(first)) {
+        first = {blocks.size() - 1, blocks.back()->tokens.size()};
+    }
+    size_t restart = 0;
+    if (first.index > 0 || first.block > 0) {
+        Position before = first.index > 0 ? Position{first.block, first.index - 1}
+                                          : Position{first.block - 1, blocks[first.block - 1]->tokens.size() - 1};
+        restart = startOf(before) + blocks[before.block]->tokens[before.index].length;
+    }
+
+    // Re-lex until a token starts, past the edit, where an old one did. That
+    // token is re-lexed as well, since what was skipped before it changed.
+    vector<Entry> fresh;
+    vector<string> freshLiterals;
+    Position old = first;
+    if (old.index >= blocks[old.block]->tokens.size()) {
+        old = {old.block + 1, 0};
+    }
+    bool synced = false;
+    SourceBuffer buffer(text.data(), text.size());
+    SourceCursor in(buffer, restart);
+    Entry entry;
+    string literal;
+    while (scan(in, entry, literal)) {
+        if (entry.offset >= editEnd) {
+            while (!atEnd(old) && (int64_t)startOf(old) + delta < (int64_t)entry.offset) {
+                old = next(old);
+            }
+            synced = !atEnd(old) && (int64_t)startOf(old) + delta == (int64_t)entry.offset;
+        }
+        if (entry.literal != NO_LITERAL) {
+            entry.literal = (uint32_t)freshLiterals.size();
+            freshLiterals.push_back(literal);
+        }
+        fresh.push_back(entry);
+        if (synced) {
+            old = next(old);
+            break;
+        }
+    }
+    relexed = fresh.size();
+
+    // Blocks [firstBlock, lastBlock] are rebuilt from the kept prefix of the
+    // first one, the fresh tokens and the kept suffix of the last one
+    size_t firstBlock = first.block;
+    size_t lastBlock;
+    size_t suffixFrom;
+    if (!synced) {
+        lastBlock = blocks.size() - 1;
+        suffixFrom = blocks[lastBlock]->tokens.size();
+    } else if (old.index == 0 && old.block > firstBlock) {
+        lastBlock = old.block - 1;
+        suffixFrom = blocks[lastBlock]->tokens.size();
+    } else {
+        lastBlock = old.block;
+        suffixFrom = old.index;
+    }
+
+    size_t removedTokens = 0;
+    for (size_t b = firstBlock; b <= lastBlock; b++) {
+        removedTokens += blocks[b]->tokens.size();
+    }
+    removedTokens -= first.index + (blocks[lastBlock]->tokens.size() - suffixFrom);
+
+    vector<unique_ptr<Block>> rebuilt;
+    for (size_t i = 0; i < first.index; i++) {
+        copyToken(rebuilt, {firstBlock, i}, 0);
+    }
+    for (const Entry& token : fresh) {
+        appendToken(rebuilt, token, token.literal == NO_LITERAL ? nullptr : &freshLiterals[token.literal]);
+    }
+    for (size_t i = suffixFrom; i < blocks[lastBlock]->tokens.size(); i++) {
+        copyToken(rebuilt, {lastBlock, i}, delta);
+    }
+
+    // Blocks after the rebuilt range move by delta. A single pending shift
+    // is kept for a suffix of the blocks; fold whichever part is shorter.
+    size_t after = lastBlock + 1;
+    size_t replaced = after - firstBlock;
+    bool pendingMoves = true;
+    if (pendingFrom >= after) {
+        if (pendingFrom - after <= blocks.size() - pendingFrom) {
+            shiftBlocks(after, pendingFrom, delta);
+            pendingDelta += delta;
+        } else {
+            shiftBlocks(pendingFrom, blocks.size(), pendingDelta);
+            pendingFrom = after;
+            pendingDelta = delta;
+        }
+    } else if (pendingFrom >= firstBlock || firstBlock - pendingFrom <= blocks.size() - after) {
+        shiftBlocks(pendingFrom, firstBlock, pendingDelta);
+        pendingFrom = after;
+        pendingDelta += delta;
+    } else {
+        // The rebuilt blocks stay inside the pending range
+        shiftBlocks(after, blocks.size(), delta);
+        for (unique_ptr<Block>& block : rebuilt) {
+            block->base = (uint32_t)(block->base - pendingDelta);
+        }
+        pendingMoves = false;
+    }
+
+    blocks.erase(blocks.begin() + firstBlock, blocks.begin() + after);
+    blocks.insert(blocks.begin() + firstBlock,
+                  make_move_iterator(rebuilt.begin()), make_move_iterator(rebuilt.end()));
+    if (pendingMoves) {
+        pendingFrom = pendingFrom - replaced + rebuilt.size();
+    }
+    count = count - removedTokens + fresh.size();
+}
+
+TokenStream IncrementalLexer::toStream() const {
+    TokenStream stream(text.data());
+    stream.reserve(count);
+    for (const TokenView& token : *this) {
+        stream.push(token);
+    }
+    return stream;
+}
+
+Diagnostics IncrementalLexer::diagnostics() const {
+    Diagnostics errors;
+    for (size_t b = 0; b < blocks.size(); b++) {
+        for (const Entry& entry : blocks[b]->tokens) {
+            if (entry.type == ERROR_TOKEN) {
+                errors.add((DiagnosticKind)entry.error, baseOf(b) + entry.offset, entry.length);
+            }
+        }
+    }
+    return errors;
+}
+
+TokenView IncrementalLexer::const_iterator::operator*() const {
+    const Block& block = *owner->blocks[at.block];
+    const Entry& entry = block.tokens[at.index];
+    TokenView token;
+    token.type = (Type)entry.type;
+    token.offset = owner->baseOf(at.block) + entry.offset;
+    token.length = entry.length;
+    token.symbol = NO_SYMBOL;
+    if (entry.literal != NO_LITERAL) {
+        token.text = block.literals[entry.literal];
+    } else {
+        token.text = lexemeText(owner->text, token.type, token.offset, token.length);
+    }
+    return token;
+}
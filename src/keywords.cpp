@@ -0,0 +1,43 @@
+#include "include/keywords.h"
+
+using namespace std;
+
+void KeywordTable::add(const string& word, Type type) {
+    if (word.empty()) return;
+
+    // Redefining a word just changes its type
+    for (ExtraWord& existing : extraWords) {
+        if (existing.text == word) {
+            existing.type = type;
+            return;
+        }
+    }
+    extraWords.push_back({word, type});
+
+    // Rebuild at load factor <= 1/2; this only runs while rules are loaded
+    size_t size = 16;
+    while (size < extraWords.size() * 2) size *= 2;
+    extraSlots.assign(size, -1);
+    for (size_t i = 0; i < extraWords.size(); i++) {
+        const string& text = extraWords[i].text;
+        size_t slot = keywordHash(KEYWORD_SEED, text.data(), text.size()) & (size - 1);
+        while (extraSlots[slot] != -1) {
+            slot = (slot + 1) & (size - 1);
+        }
+        extraSlots[slot] = (int32_t)i;
+    }
+}
+
+bool KeywordTable::lookupExtra(string_view word, Type& type) const {
+    size_t mask = extraSlots.size() - 1;
+    size_t slot = keywordHash(KEYWORD_SEED, word.data(), word.size()) & mask;
+    while (extraSlots[slot] != -1) {
+        const ExtraWord& candidate = extraWords[extraSlots[slot]];
+        if (candidate.text == word) {
+            type = candidate.type;
+            return true;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return false;
+}
@@ -1,513 +1,787 @@
+#include <cerrno>
 #include <cstdio>
+#include <cstring>
 #include <vector>
 #include <cctype>
 #include <string>
+#include <string_view>
 #include <map>
 #include <utility>
 
 #include "include/lexer.h"
 #include "include/token.h"
 #include "include/dfa.h"
+#include "include/keywords.h"
+#include "include/source.h"
+#include "include/token_stream.h"
+#include "include/scan.h"
+#include "include/lexicon.h"
+#include "include/direct_lexer.h"
+#include "include/diagnostics.h"
+#include "include/symbol_table.h"
+#include "include/token_cache.h"
 
 using namespace std;
 
+// Bytes that interrupt a plain run inside a switch-mode literal
+static const StopBytes LITERAL_STOPS('\'', '\\');
+
 // Constructor
-Lexer::Lexer(LexerMode mode, const string& dfaRulesFile) : mode(mode) {
+Lexer::Lexer(LexerMode mode, const string& dfaRulesFile, pmr::memory_resource* memory) : mode(mode), dfa(memory) {
     if (mode == DFA_MODE) {
-        if (!dfa.loadDFAFromFile(dfaRulesFile)) {
+        initializeStateMapping();
+        if (!dfa.loadRules(dfaRulesFile)) {
             printf("ERROR: Failed to load DFA rules from %s\n", dfaRulesFile.c_str());
             printf("Falling back to switch-based lexer\n");
             this->mode = SWITCH_MODE;
-        } else {
-            initializeStateMapping();
         }
+    } else if (mode == SWITCH_MODE) {
+        // Switch mode only needs the reserved words declared in the rules
+        dfa.loadRules(dfaRulesFile);
     }
+    initializeKeywords();
 }
 
-// Common helper methods
-bool Lexer::isPascalKeyword(const string& word) {
-    return (word == "program" || word == "var" || word == "procedure" || 
-            word == "begin" || word == "end" || word == "if" || word == "then" || 
-            word == "else" || word == "while" || word == "do" || word == "for" ||
-            word == "to" || word == "downto" || word == "integer" || word == "real" ||
-            word == "boolean" || word == "char" || word == "array" || word == "of" ||
-            word == "function" || word == "const" || word == "type");
+Lexer::Lexer(LexerMode mode, DFA&& rules) : mode(mode), dfa(move(rules)) {
+    initializeKeywords();
 }
 
-bool Lexer::isLogicalOperator(const string& word) {
-    return (word == "and" || word == "or" || word == "not");
+void Lexer::initializeKeywords() {
+    for (const auto& word : dfa.getReservedWords()) {
+        keywords.add(word.first, word.second);
+    }
+    
+    // Direct mode has the rules compiled in at build time, reserved words included
+    if (mode == DIRECT_MODE) {
+        for (size_t i = 0; i < DIRECT_RESERVED_WORD_COUNT; i++) {
+            keywords.add(DIRECT_RESERVED_WORDS[i].text, DIRECT_RESERVED_WORDS[i].type);
+        }
+    }
 }
 
-bool Lexer::isArithmeticOperator(const string& word) {
-    return (word == "div" || word == "mod");
+// Common helper methods
+void Lexer::skipWhitespace(SourceCursor& in) const {
+    in.pos = skipSpaces(in.pos, in.end);
 }
 
-void Lexer::skipWhitespace(FILE* file) {
-    int c;
-    while ((c = fgetc(file)) != EOF) {
-        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
-            ungetc(c, file);
-            break;
+// Helper method to skip brace comments { ... }; false if it never closes
+bool Lexer::skipBraceComment(SourceCursor& in) const {
+    in.pos = findByte(in.pos, in.end, '}');
+    if (in.pos >= in.end) return false;
+    // The closing brace is consumed too
+    in.pos++;
+    return true;
+}
+
+// Helper method to skip parenthesis comments (* ... *); false if it never closes
+bool Lexer::skipParenComment(SourceCursor& in) const {
+    // Jump from star to star until one is followed by ')'
+    for (;;) {
+        in.pos = findByte(in.pos, in.end, '*');
+        if (in.pos >= in.end) return false;
+        in.pos++;
+        if (in.pos < in.end && *in.pos == ')') {
+            in.pos++;   // the closing *) is consumed
+            return true;
         }
     }
 }
 
-// Helper method to skip brace comments { ... }
-void Lexer::skipBraceComment(FILE* file) {
-    int c;
-    while ((c = fgetc(file)) != EOF && c != '}') {
-        // Just consume characters until closing brace
+// Fill token with the lexeme between start and the cursor
+static bool emitToken(TokenView& token, Type type, const SourceCursor& in, const char* start) {
+    token.type = type;
+    token.text = string_view(start, in.pos - start);
+    token.offset = (uint32_t)(start - in.begin);
+    token.length = (uint32_t)(in.pos - start);
+    token.symbol = NO_SYMBOL;
+    return true;
+}
+
+// Give an identifier its symbol id when the cursor interns names
+static void internIdentifier(const SourceCursor& in, TokenView& token) {
+    if (token.type == IDENTIFIER && in.symbols != nullptr) {
+        token.symbol = in.symbols->intern(token.text);
     }
-    // No need to put back the closing brace - it's consumed
 }
 
-// Helper method to skip parenthesis comments (* ... *)
-void Lexer::skipParenComment(FILE* file) {
-    int c;
-    int prev_c = 0;
-    while ((c = fgetc(file)) != EOF) {
-        if (prev_c == '*' && c == ')') {
-            break;
-        }
-        prev_c = c;
+// Switch-mode dispatch class of every byte
+enum CharClass : uint8_t {
+    CHAR_INVALID,       // cannot start whitespace, a comment or a token
+    CHAR_SPACE,
+    CHAR_LETTER,        // letters and '_'
+    CHAR_DIGIT,
+    CHAR_SINGLE,        // always a one-byte token, typed by CharTable::types
+    CHAR_LESS,
+    CHAR_GREATER,
+    CHAR_COLON,
+    CHAR_DOT,
+    CHAR_LPAREN,
+    CHAR_QUOTE,
+    CHAR_LBRACE,
+    CHAR_RBRACE
+};
+
+struct CharTable {
+    uint8_t classes[256];
+    uint8_t types[256];
+
+    constexpr void single(char c, Type type) {
+        classes[(unsigned char)c] = CHAR_SINGLE;
+        types[(unsigned char)c] = (uint8_t)type;
     }
-    // No need to put back - the closing *) is consumed
+
+    constexpr CharTable() : classes(), types() {
+        for (int c = 'a'; c <= 'z'; c++) classes[c] = CHAR_LETTER;
+        for (int c = 'A'; c <= 'Z'; c++) classes[c] = CHAR_LETTER;
+        for (int c = '0'; c <= '9'; c++) classes[c] = CHAR_DIGIT;
+        classes['_'] = CHAR_LETTER;
+        classes[' '] = classes['\t'] = classes['\n'] = classes['\r'] = CHAR_SPACE;
+        single('+', ARITHMETIC_OPERATOR);
+        single('-', ARITHMETIC_OPERATOR);
+        single('*', ARITHMETIC_OPERATOR);
+        single('/', ARITHMETIC_OPERATOR);
+        single('=', RELATIONAL_OPERATOR);
+        single(';', SEMICOLON);
+        single(',', COMMA);
+        single(')', RPARENTHESIS);
+        single('[', LBRACKET);
+        single(']', RBRACKET);
+        classes['<'] = CHAR_LESS;
+        classes['>'] = CHAR_GREATER;
+        classes[':'] = CHAR_COLON;
+        classes['.'] = CHAR_DOT;
+        classes['('] = CHAR_LPAREN;
+        classes['\''] = CHAR_QUOTE;
+        classes['{'] = CHAR_LBRACE;
+        classes['}'] = CHAR_RBRACE;
+    }
+};
+
+static constexpr CharTable CHARS;
+
+static inline uint8_t charClass(char c) {
+    return CHARS.classes[(unsigned char)c];
 }
 
-// Switch-based token reading
-Token* Lexer::readTokenSwitch(FILE* file) {
-    int c = fgetc(file);
-    
-    if (c == EOF) {
-        return nullptr;
+// End of the run of bytes of class cls, or of letters and digits for CHAR_LETTER
+static inline const char* skipClass(const char* p, const char* end, uint8_t cls) {
+    if (cls == CHAR_LETTER) {
+        while (p < end && (uint8_t)(charClass(*p) - CHAR_LETTER) <= CHAR_DIGIT - CHAR_LETTER) p++;
+    } else {
+        while (p < end && charClass(*p) == cls) p++;
     }
+    return p;
+}
+
+// Where lexing resumes after a bad byte at p: the next byte that could start something
+static const char* resyncPoint(const char* p, const char* end) {
+    if (p < end) p++;
+    while (p < end && charClass(*p) == CHAR_INVALID) p++;
+    return p;
+}
+
+// Error recovery: record the error and hand back [start, resume) as an
+// ERROR_TOKEN. Only called when the cursor has a Diagnostics buffer.
+__attribute__((noinline, cold))
+static bool lexicalError(SourceCursor& in, TokenView& token, DiagnosticKind kind,
+                         const char* start, const char* resume) {
+    in.diagnostics->add(kind, start - in.begin, resume - start);
+    in.pos = resume;
+    return emitToken(token, ERROR_TOKEN, in, start);
+}
+
+// DFA and direct mode recovery when nothing matched at start. stop is the
+// byte the automaton got stuck on: an open literal or comment ends there.
+__attribute__((noinline, cold))
+static bool recoverLexeme(SourceCursor& in, TokenView& token, const char* start, const char* stop) {
+    if (stop > start && *start == '\'') {
+        return lexicalError(in, token, UNTERMINATED_LITERAL, start, stop);
+    }
+    if (stop > start && *start == '{') {
+        return lexicalError(in, token, UNTERMINATED_COMMENT, start, stop);
+    }
+    if (stop == start && *start == '}') {
+        return lexicalError(in, token, UNMATCHED_BRACE, start, start + 1);
+    }
+    return lexicalError(in, token, UNRECOGNIZED_CHARACTER, start, resyncPoint(stop, in.end));
+}
+
+// Switch-based token reading. Comments loop back instead of recursing, so
+// runs of comments need no stack.
+bool Lexer::readTokenSwitch(SourceCursor& in, TokenView& token) const {
+    for (;;) {
+        const char* start = in.pos;
+        if (start >= in.end) {
+            return false;
+        }
     
-    switch(c) {
-        case 'a'...'z':
-        case 'A'...'Z':
-        case '_': {
-            string value(1, (char)c);
-            int next_c;
-            while ((next_c = fgetc(file)) != EOF && (isalnum(next_c) || next_c == '_')) {
-                value += (char)next_c;
-            }
-            if (next_c != EOF) {
-                ungetc(next_c, file);
-            }
+        // Byte after the first one, or 0 at the end (a class no rule continues with)
+        char c = *in.pos++;
+        char next = in.pos < in.end ? *in.pos : '\0';
+        switch (charClass(c)) {
+            case CHAR_LETTER: {
+                in.pos = skipClass(in.pos, in.end, CHAR_LETTER);
             
-            if (isPascalKeyword(value)) {
-                return new Token(KEYWORD, value);
-            } else if (isLogicalOperator(value)) {
-                return new Token(LOGICAL_OPERATOR, value);
-            } else if (isArithmeticOperator(value)) {
-                return new Token(ARITHMETIC_OPERATOR, value);
-            } else {
-                return new Token(IDENTIFIER, value);
+                // Reserved words and word operators share one table probe
+                Type type = IDENTIFIER;
+                keywords.lookup(string_view(start, in.pos - start), type);
+                emitToken(token, type, in, start);
+                internIdentifier(in, token);
+                return true;
             }
-        }
         
-        case '0'...'9': {
-            string value(1, (char)c);
-            int next_c;
-            
-            // Handle integer part only - no decimal point handling
-            while ((next_c = fgetc(file)) != EOF && isdigit(next_c)) {
-                value += (char)next_c;
-            }
-            
-            // Put back the non-digit character
-            if (next_c != EOF) {
-                ungetc(next_c, file);
-            }
-            
-            return new Token(NUMBER, value);
-        }
+            case CHAR_DIGIT:
+                // Integer part only - no decimal point handling
+                in.pos = skipClass(in.pos, in.end, CHAR_DIGIT);
+                return emitToken(token, NUMBER, in, start);
         
-        case '+':
-        case '-':
-        case '/':
-            return new Token(ARITHMETIC_OPERATOR, string(1, (char)c));
-            
-        case '*':
-            return new Token(ARITHMETIC_OPERATOR, "*");
-            
-        case '=':
-            return new Token(RELATIONAL_OPERATOR, "=");
-            
-        case '<': {
-            int next_c = fgetc(file);
-            if (next_c == '>') {
-                return new Token(RELATIONAL_OPERATOR, "<>");
-            } else if (next_c == '=') {
-                return new Token(RELATIONAL_OPERATOR, "<=");
-            } else {
-                if (next_c != EOF) {
-                    ungetc(next_c, file);
-                }
-                return new Token(RELATIONAL_OPERATOR, "<");
-            }
-        }
+            case CHAR_SINGLE:
+                return emitToken(token, (Type)CHARS.types[(unsigned char)c], in, start);
         
-        case '>': {
-            int next_c = fgetc(file);
-            if (next_c == '=') {
-                return new Token(RELATIONAL_OPERATOR, ">=");
-            } else {
-                if (next_c != EOF) {
-                    ungetc(next_c, file);
+            case CHAR_LESS:
+                // <, <= and <>
+                if (next == '=' || next == '>') in.pos++;
+                return emitToken(token, RELATIONAL_OPERATOR, in, start);
+        
+            case CHAR_GREATER:
+                // > and >=
+                if (next == '=') in.pos++;
+                return emitToken(token, RELATIONAL_OPERATOR, in, start);
+        
+            case CHAR_COLON:
+                if (next == '=') {
+                    in.pos++;
+                    return emitToken(token, ASSIGN_OPERATOR, in, start);
                 }
-                return new Token(RELATIONAL_OPERATOR, ">");
-            }
-        }
+                return emitToken(token, COLON, in, start);
         
-        case ':': {
-            int next_c = fgetc(file);
-            if (next_c == '=') {
-                return new Token(ASSIGN_OPERATOR, ":=");
-            } else {
-                if (next_c != EOF) {
-                    ungetc(next_c, file);
+            case CHAR_DOT:
+                if (next == '.') {
+                    in.pos++;
+                    return emitToken(token, RANGE_OPERATOR, in, start);
                 }
-                return new Token(COLON, ":");
-            }
-        }
+                return emitToken(token, DOT, in, start);
         
-        case ';':
-            return new Token(SEMICOLON, ";");
-            
-        case ',':
-            return new Token(COMMA, ",");
-            
-        case '.': {
-            int next_c = fgetc(file);
-            if (next_c == '.') {
-                return new Token(RANGE_OPERATOR, "..");
-            } else {
-                if (next_c != EOF) {
-                    ungetc(next_c, file);
+            case CHAR_LBRACE:
+                // Skip brace comments - read until closing brace
+                if (!skipBraceComment(in) && in.diagnostics != nullptr) {
+                    return lexicalError(in, token, UNTERMINATED_COMMENT, start, in.pos);
                 }
-                return new Token(DOT, ".");
-            }
-        }
+                // Skip whitespace after comment and continue to next token
+                skipWhitespace(in);
+                continue;
         
-        case ')':
-            return new Token(RPARENTHESIS, ")");
-            
-        case '[':
-            return new Token(LBRACKET, "[");
-            
-        case ']':
-            return new Token(RBRACKET, "]");
-            
-        case '{': {
-            // Skip brace comments - read until closing brace
-            skipBraceComment(file);
-            // Skip whitespace after comment and continue to next token
-            skipWhitespace(file);
-            return readTokenSwitch(file);
-        }
+            case CHAR_LPAREN:
+                if (next != '*') {
+                    return emitToken(token, LPARENTHESIS, in, start);
+                }
+                // Skip parenthesis comments - read until closing *)
+                in.pos++;
+                if (!skipParenComment(in) && in.diagnostics != nullptr) {
+                    return lexicalError(in, token, UNTERMINATED_COMMENT, start, in.pos);
+                }
+                skipWhitespace(in);
+                continue;
         
-        case '}':
-            printf("ERROR: Unexpected closing brace '}' at position %ld - no matching opening brace\n", ftell(file) - 1);
-            exit(1);
+            case CHAR_RBRACE:
+                if (in.diagnostics != nullptr) {
+                    return lexicalError(in, token, UNMATCHED_BRACE, start, in.pos);
+                }
+                printf("ERROR: Unexpected closing brace '}' at position %ld - no matching opening brace\n", in.offset() - 1);
+                exit(1);
         
-        case '\'': {
-            // Pascal string and character literals use single quotes
-            string value = "";
-            int next_c;
+            case CHAR_QUOTE: {
+                // Pascal string and character literals use single quotes
+                pmr::string& value = in.scratch;
+                value.clear();
+                bool escaped = false;
+                int next_c;
             
-            while ((next_c = fgetc(file)) != '\'' && next_c != EOF) {
-                if (next_c == '\\') {
-                    // Handle escape sequences
-                    int escaped = fgetc(file);
-                    if (escaped != EOF) {
-                        switch (escaped) {
-                            case 'n': value += '\n'; break;
-                            case 't': value += '\t'; break;
-                            case 'r': value += '\r'; break;
-                            case '\\': value += '\\'; break;
-                            case '\'': value += '\''; break;
-                            default: 
-                                value += '\\';
-                                value += (char)escaped;
-                                break;
+                for (;;) {
+                    // Copy the plain run up to the next quote or backslash at once
+                    const char* run = findStop(LITERAL_STOPS, in.pos, in.end);
+                    value.append(in.pos, run - in.pos);
+                    in.pos = run;
+                    next_c = in.get();
+                    if (next_c == '\'' || next_c == EOF) {
+                        break;
+                    }
+                    if (next_c == '\\') {
+                        // Handle escape sequences
+                        escaped = true;
+                        int escape = in.get();
+                        if (escape != EOF) {
+                            switch (escape) {
+                                case 'n': value += '\n'; break;
+                                case 't': value += '\t'; break;
+                                case 'r': value += '\r'; break;
+                                case '\\': value += '\\'; break;
+                                case '\'': value += '\''; break;
+                                default: 
+                                    value += '\\';
+                                    value += (char)escape;
+                                    break;
+                            }
                         }
+                    } else {
+                        value += (char)next_c;
                     }
-                } else {
-                    value += (char)next_c;
                 }
-            }
             
-            if (next_c == EOF) {
-                printf("ERROR: Unterminated literal at position %ld\n", ftell(file) - 1);
-                exit(1);
-            }
+                if (next_c == EOF) {
+                    if (in.diagnostics != nullptr) {
+                        // A literal cannot span lines, so the rest of its line goes with it
+                        const char* line = findByte(start, in.end, '\n');
+                        return lexicalError(in, token, UNTERMINATED_LITERAL, start, line);
+                    }
+                    printf("ERROR: Unterminated literal at position %ld\n", in.offset() - 1);
+                    exit(1);
+                }
             
-            // Distinguish between character literals and string literals to match DFA behavior
-            // Empty ('') and single character ('a') → CHAR_LITERAL
-            // Multi-character ('abc') → STRING_LITERAL
-            if (value.length() <= 1) {
-                return new Token(CHAR_LITERAL, value);
-            } else {
-                return new Token(STRING_LITERAL, value);
+                // Distinguish between character literals and string literals to match DFA behavior
+                // Empty ('') and single character ('a', 'é') → CHAR_LITERAL
+                // Multi-character ('abc') → STRING_LITERAL
+                bool single = value.length() <= 1 || countCodePoints(value.data(), value.data() + value.length()) <= 1;
+                emitToken(token, single ? CHAR_LITERAL : STRING_LITERAL, in, start);
+                if (escaped) {
+                    token.text = value;
+                } else {
+                    token.text = string_view(start + 1, in.pos - start - 2);
+                }
+                return true;
             }
-        }
         
-        case '(': {
-            int next_c = fgetc(file);
-            if (next_c == '*') {
-                // Skip parenthesis comments - read until closing *)
-                skipParenComment(file);
-                // Skip whitespace after comment and continue to next token
-                skipWhitespace(file);
-                return readTokenSwitch(file);
-            } else {
-                if (next_c != EOF) {
-                    ungetc(next_c, file);
+            default:
+                if (in.diagnostics != nullptr) {
+                    return lexicalError(in, token, UNRECOGNIZED_CHARACTER, start, resyncPoint(start, in.end));
                 }
-                return new Token(LPARENTHESIS, "(");
-            }
+                printf("ERROR: Unrecognized character '%s' at position %ld\n", printableByte(c).c_str(),
+                       in.offset() - 1);
+                exit(1);
         }
-        
-        default:
-            printf("ERROR: Unrecognized character '%c' at position %ld\n", (char)c, ftell(file) - 1);
-            exit(1);
     }
-    
-    return nullptr;
 }
 
 // DFA-based lexer methods
 
-// Initialize DFA state to token type mapping
+// Hand the token tag of every state name to the DFA; runs before the rules are loaded
 void Lexer::initializeStateMapping() {
-    stateToTokenType["S_ID"] = IDENTIFIER;
-    stateToTokenType["S_NUM"] = NUMBER;
-
-    stateToTokenType["S_CHAR_LITERAL"] = CHAR_LITERAL;
-    stateToTokenType["S_SINGLE_CHAR"] = CHAR_LITERAL;
-
-    stateToTokenType["S_STRING_LITERAL"] = STRING_LITERAL;
-    stateToTokenType["S_STR_END"] = STRING_LITERAL;
-    stateToTokenType["S_SEMICOLON"] = SEMICOLON;
-    stateToTokenType["S_COMMA"] = COMMA;
-    stateToTokenType["S_COLON_TEMP"] = COLON;
-    stateToTokenType["S_DOT_TEMP"] = DOT;
-    stateToTokenType["S_LPARENTHESIS"] = LPARENTHESIS;
-    stateToTokenType["S_LPAREN_TEMP"] = LPARENTHESIS;
-    stateToTokenType["S_RPARENTHESIS"] = RPARENTHESIS;
-    stateToTokenType["S_LBRACKET"] = LBRACKET;
-    stateToTokenType["S_RBRACKET"] = RBRACKET;
-    stateToTokenType["S_PLUS"] = ARITHMETIC_OPERATOR;
-    stateToTokenType["S_MINUS"] = ARITHMETIC_OPERATOR;
-    stateToTokenType["S_MULTIPLY"] = ARITHMETIC_OPERATOR;
-    stateToTokenType["S_DIVIDE"] = ARITHMETIC_OPERATOR;
-    stateToTokenType["S_ASSIGN"] = ASSIGN_OPERATOR;
-    stateToTokenType["S_EQ"] = RELATIONAL_OPERATOR;
-    stateToTokenType["S_NE"] = RELATIONAL_OPERATOR;
-    stateToTokenType["S_LT_TEMP"] = RELATIONAL_OPERATOR;
-    stateToTokenType["S_LE"] = RELATIONAL_OPERATOR;
-    stateToTokenType["S_GT_TEMP"] = RELATIONAL_OPERATOR;
-    stateToTokenType["S_GE"] = RELATIONAL_OPERATOR;
-    stateToTokenType["S_RANGE"] = RANGE_OPERATOR;
-
-}
-
-Token* Lexer::createToken(const string& state, const string& value) {
-    // Check if this is a comment state - if so, return nullptr to indicate skip
-    if (state == "S_COMMENT_SINGLE" || state == "S_COMMENT_MULTI") {
-        return nullptr;  // Signal to skip this token
+    // The DFA resolves these per state id while compiling, so token creation
+    // only indexes by id and states with the same token can be merged
+    dfa.setStateTagNames(lexiconStateTags());
+}
+
+uint64_t Lexer::fingerprint() const {
+    uint8_t modeTag = (uint8_t)mode;
+    return hashBytes(&modeTag, 1, mode == DIRECT_MODE ? DIRECT_RULES_FINGERPRINT : dfa.fingerprint());
+}
+
+bool Lexer::compileRules(const string& outputFile, const string& rulesFile) const {
+    if (mode != DFA_MODE) {
+        return false;
     }
-    
-    auto it = stateToTokenType.find(state);
-    if (it == stateToTokenType.end()) {
-        printf("ERROR: Unknown DFA state: %s\n", state.c_str());
+    return dfa.saveCompiled(outputFile, rulesFile);
+}
+
+// Tag of the longest match: from the generated code in direct mode, else
+// from the DFA tables. STATE_NO_MATCH if no prefix was accepted.
+template <bool PROFILE>
+int Lexer::matchLexeme(const SourceCursor& in, const char*& lastFinalPos, const char*& stop) const {
+    if (mode == DIRECT_MODE) {
+        return directMatch(in.pos, in.end, lastFinalPos, stop);
+    }
+    uint16_t state = matchDFA<PROFILE>(in, lastFinalPos, stop);
+    if (state == DFA::ERROR_STATE) {
+        return STATE_NO_MATCH;
+    }
+    int mapped = dfa.getStateTag(state);
+    if (mapped == STATE_UNMAPPED && in.diagnostics == nullptr) {
+        printf("ERROR: Unknown DFA state: %s\n", dfa.getStateName(state).c_str());
         exit(1);
     }
+    return mapped;
+}
+
+bool Lexer::createToken(int tag, SourceCursor& in, const char* start, TokenView& token) const {
+    // Check if this is a comment state - if so, return false to indicate skip
+    if (tag == STATE_COMMENT) {
+        return false;  // Signal to skip this token
+    }
     
-    Type tokenType = it->second;
+    Type tokenType = (Type)tag;
+    emitToken(token, tokenType, in, start);
+    string_view value = token.text;
     
     // Special handling for identifiers that might be keywords or operators
     if (tokenType == IDENTIFIER) {
-        if (isPascalKeyword(value)) {
-            tokenType = KEYWORD;
-        } else if (isLogicalOperator(value)) {
-            tokenType = LOGICAL_OPERATOR;
-        } else if (isArithmeticOperator(value)) {
-            tokenType = ARITHMETIC_OPERATOR;
-        }
+        keywords.lookup(value, token.type);
+        internIdentifier(in, token);
     }
     
     // Special handling for string literals - remove quotes and process escape sequences
     if (tokenType == STRING_LITERAL || tokenType == CHAR_LITERAL) {
         if (value.length() >= 2 && value[0] == '\'' && value[value.length()-1] == '\'') {
-            string raw_content = value.substr(1, value.length() - 2);
-            string processed_content = "";
+            string_view raw_content = value.substr(1, value.length() - 2);
             
-            // Process escape sequences in the content
-            for (size_t i = 0; i < raw_content.length(); i++) {
-                if (raw_content[i] == '\\' && i + 1 < raw_content.length()) {
-                    char next_char = raw_content[i + 1];
-                    switch (next_char) {
-                        case 'n': processed_content += '\n'; break;
-                        case 't': processed_content += '\t'; break;
-                        case 'r': processed_content += '\r'; break;
-                        case '\\': processed_content += '\\'; break;
-                        case '\'': processed_content += '\''; break;
-                        default:
-                            processed_content += '\\';
-                            processed_content += next_char;
-                            break;
+            // Only literals with escapes need a processed copy
+            if (raw_content.find('\\') == string_view::npos) {
+                token.text = raw_content;
+            } else {
+                pmr::string& processed_content = in.scratch;
+                processed_content.clear();
+                
+                // Process escape sequences in the content
+                for (size_t i = 0; i < raw_content.length(); i++) {
+                    if (raw_content[i] == '\\' && i + 1 < raw_content.length()) {
+                        char next_char = raw_content[i + 1];
+                        switch (next_char) {
+                            case 'n': processed_content += '\n'; break;
+                            case 't': processed_content += '\t'; break;
+                            case 'r': processed_content += '\r'; break;
+                            case '\\': processed_content += '\\'; break;
+                            case '\'': processed_content += '\''; break;
+                            default:
+                                processed_content += '\\';
+                                processed_content += next_char;
+                                break;
+                        }
+                        i++; // Skip the next character as it's part of the escape sequence
+                    } else {
+                        processed_content += raw_content[i];
                     }
-                    i++; // Skip the next character as it's part of the escape sequence
-                } else {
-                    processed_content += raw_content[i];
                 }
+                token.text = processed_content;
             }
             
             // Post-processing fix: Convert STRING_LITERAL to CHAR_LITERAL for single characters
             // This ensures DFA and switch lexers agree on single escaped characters like '\n'
-            if (tokenType == STRING_LITERAL && processed_content.length() <= 1) {
-                tokenType = CHAR_LITERAL;
+            if (tokenType == STRING_LITERAL && token.text.length() <= 1) {
+                token.type = CHAR_LITERAL;
             }
-            
-            return new Token(tokenType, processed_content);
         }
     }
     
-    return new Token(tokenType, value);
+    return true;
+}
+
+// Profile counters of one DFA run: backtracking, and where the bytes went
+static void countLexeme(LexProfile& profile, int tag, const char* start, const char* lastFinalPos,
+                        const char* stop) {
+    profile.lexemes++;
+    if (tag == STATE_NO_MATCH) {
+        return;
+    }
+    if (stop > lastFinalPos) {
+        profile.backtracks++;
+        profile.rescannedBytes += stop - lastFinalPos;
+    }
+    if (tag == STATE_COMMENT) {
+        profile.commentBytes += lastFinalPos - start;
+    } else if (tag == STRING_LITERAL || tag == CHAR_LITERAL) {
+        profile.literalBytes += lastFinalPos - start;
+    }
 }
 
 // DFA-based token reading
-Token* Lexer::readTokenDFA(FILE* file) {
-    skipWhitespace(file);
+// Run the DFA from in.pos as far as it goes. Returns the last accepting
+// state (ERROR_STATE if none) and where its lexeme ends; stop is the byte
+// the DFA got stuck on, or in.end, or the lexeme end if it was terminal.
+//
+// Accepting states with at most one byte of lookahead are only ever left
+// for another accepting state (see DFA::analyseLookahead), so the state the
+// run ends in decides the match. Only the few states after which the
+// automaton may wander off without accepting are remembered on the way.
+template <bool PROFILE>
+uint16_t Lexer::matchDFA(const SourceCursor& in, const char*& lastFinalPos, const char*& stop) const {
+    const char* p = in.pos;
+    uint16_t currentState = dfa.getStartId();
+    uint16_t lastFinalState = DFA::ERROR_STATE;
+    lastFinalPos = p;
     
-    if (feof(file)) {
-        return nullptr;
+    while (p < in.end) {
+        uint16_t nextState = dfa.next(currentState, (unsigned char)*p);
+        if (nextState == DFA::ERROR_STATE) {
+            break;
+        }
+        if (PROFILE) {
+            in.profile->stateVisits[nextState]++;
+            in.profile->transitions[currentState * in.profile->states + nextState]++;
+        }
+        currentState = nextState;
+        p++;
+        uint8_t flags = dfa.getFlags(currentState);
+        if (flags == 0) {
+            continue;
+        }
+        if (flags & DFA::STATE_ACCELERATED) {
+            const char* loop = p;
+            p = dfa.skipLoop(currentState, p, in.end);
+            if (PROFILE) {
+                in.profile->stateVisits[currentState] += p - loop;
+                in.profile->transitions[currentState * in.profile->states + currentState] += p - loop;
+            }
+        }
+        if (flags & DFA::STATE_BACKTRACK_POINT) {
+            lastFinalState = currentState;
+            lastFinalPos = p;
+        }
+        // Nothing can follow: commit without reading the next byte
+        if (flags & DFA::STATE_TERMINAL) {
+            break;
+        }
     }
-    
-    string currentState = dfa.getStartState();
-    string tokenValue = "";
-    string lastFinalState = "";
-    string lastFinalValue = "";
-    long lastFinalPosition = ftell(file);
-    
-    int c;
-    while ((c = fgetc(file)) != EOF) {
-        char input = (char)c;
-        string nextState = dfa.getNextState(currentState, input);
+    stop = p;
+    if (p != in.pos && dfa.isAccepting(currentState)) {
+        lastFinalState = currentState;
+        lastFinalPos = p;
+    }
+    return lastFinalState;
+}
+
+template <bool PROFILE>
+bool Lexer::readTokenDFA(SourceCursor& in, TokenView& token) const {
+    for (;;) {
+        skipWhitespace(in);
+        
+        if (in.atEnd()) {
+            return false;
+        }
+        
+        const char* start = in.pos;
+        const char* lastFinalPos;
+        const char* p;
+        int tag = matchLexeme<PROFILE>(in, lastFinalPos, p);
+        if (PROFILE) {
+            countLexeme(*in.profile, tag, start, lastFinalPos, p);
+        }
         
-        if (nextState == "ERROR") {
-            // Can't continue, check if we have a valid token
-            if (!lastFinalState.empty()) {
-                // Backtrack to last final state position
-                fseek(file, lastFinalPosition, SEEK_SET);
-                Token* token = createToken(lastFinalState, lastFinalValue);
-                if (token == nullptr) {
-                    // It was a comment, recursively get next token
-                    return readTokenDFA(file);
+        if (tag == STATE_NO_MATCH || tag == STATE_UNMAPPED) {
+            if (in.diagnostics != nullptr) {
+                if (tag == STATE_UNMAPPED) {
+                    return lexicalError(in, token, UNKNOWN_STATE, start, lastFinalPos);
                 }
-                return token;
-            } else {
-                printf("ERROR: Unrecognized character '%c' at position %ld\n", input, ftell(file) - 1);
+                return recoverLexeme(in, token, start, p);
+            }
+            if (p < in.end) {
+                printf("ERROR: Unrecognized character '%s' at position %ld\n", printableByte(*p).c_str(),
+                       (long)(p - in.begin));
                 exit(1);
             }
+            // Unfinished token at end of input
+            in.pos = in.end;
+            return false;
         }
         
-        // Add character to token value
-        tokenValue += input;
-        currentState = nextState;
-        
-        // Check if current state is final
-        if (dfa.isFinalState(currentState)) {
-            lastFinalState = currentState;
-            lastFinalValue = tokenValue;
-            lastFinalPosition = ftell(file);
+        // Backtracking is just moving the cursor to the end of the accepted prefix
+        in.pos = lastFinalPos;
+        if (createToken(tag, in, start, token)) {
+            return true;
         }
+        // It was a comment, go on to the next token
+    }
+}
+
+ScanResult Lexer::scanLexeme(SourceCursor& in, TokenView& token, const char** stop) const {
+    skipWhitespace(in);
+    if (in.atEnd()) {
+        return SCAN_END;
     }
     
-    // End of file reached
-    if (dfa.isFinalState(currentState)) {
-        Token* token = createToken(currentState, tokenValue);
-        if (token == nullptr) {
-            // It was a comment, recursively get next token
-            return readTokenDFA(file);
+    const char* start = in.pos;
+    const char* lastFinalPos;
+    const char* p;
+    int tag;
+    if (mode == DIRECT_MODE) {
+        tag = directMatch(in.pos, in.end, lastFinalPos, p);
+    } else {
+        uint16_t state = matchDFA<false>(in, lastFinalPos, p);
+        tag = state == DFA::ERROR_STATE ? STATE_NO_MATCH : dfa.getStateTag(state);
+    }
+    if (stop != nullptr) {
+        *stop = p;
+    }
+    if ((tag == STATE_UNMAPPED || tag == STATE_NO_MATCH) && in.diagnostics != nullptr) {
+        if (tag == STATE_UNMAPPED) {
+            lexicalError(in, token, UNKNOWN_STATE, start, lastFinalPos);
+        } else {
+            recoverLexeme(in, token, start, p);
         }
-        return token;
-    } else if (!lastFinalState.empty()) {
-        fseek(file, lastFinalPosition, SEEK_SET);
-        Token* token = createToken(lastFinalState, lastFinalValue);
-        if (token == nullptr) {
-            // It was a comment, recursively get next token
-            return readTokenDFA(file);
+        return SCAN_TOKEN;
+    }
+    if (tag == STATE_UNMAPPED) {
+        return SCAN_ERROR;
+    }
+    
+    if (tag == STATE_NO_MATCH) {
+        if (p < in.end) {
+            return SCAN_ERROR;
         }
-        return token;
+        in.pos = in.end;
+        return SCAN_END;
     }
     
-    return nullptr;
+    in.pos = lastFinalPos;
+    if (createToken(tag, in, start, token)) {
+        return SCAN_TOKEN;
+    }
+    token.offset = (uint32_t)(start - in.begin);
+    token.length = (uint32_t)(lastFinalPos - start);
+    return SCAN_COMMENT;
 }
 
 // Main token reading method - delegates to appropriate implementation
-Token* Lexer::readToken(FILE* file) {
-    if (mode == DFA_MODE) {
-        return readTokenDFA(file);
+bool Lexer::readToken(SourceCursor& in, TokenView& token) const {
+    if (mode == SWITCH_MODE) {
+        return readTokenSwitch(in, token);
+    } else if (in.profile != nullptr) {
+        return readTokenDFA<true>(in, token);
     } else {
-        return readTokenSwitch(file);
+        return readTokenDFA<false>(in, token);
     }
 }
 
-// Main lexing method
-vector<Token*> Lexer::lex(FILE* file) {
-    vector<Token*> tokens;
-    Token* token;
-    
-    // Skip initial whitespace for switch-based lexer
-    if (mode == SWITCH_MODE) {
-        skipWhitespace(file);
-    }
-    
-    while (!feof(file)) {
+// One step of the lexing loop: skip separators and read the next token
+bool Lexer::nextToken(SourceCursor& in, TokenView& token) const {
+    while (!in.atEnd()) {
         // For switch mode, skip whitespace between tokens
         if (mode == SWITCH_MODE) {
-            skipWhitespace(file);
-            if (feof(file)) break;
+            skipWhitespace(in);
+            if (in.atEnd()) break;
         }
         
-        token = readToken(file);
-        if (token != nullptr) {
-            tokens.push_back(token);
-            printf("%s\n", token->toString().c_str());
-        } else if (mode == SWITCH_MODE && !feof(file)) {
+        if (readToken(in, token)) {
+            return true;
+        } else if (mode == SWITCH_MODE && !in.atEnd()) {
             // Only report error if we're not at EOF
-            int c = fgetc(file);
+            int c = in.get();
             if (c != EOF) {
-                printf("ERROR: Unrecognized character '%c' at position %ld\n", (char)c, ftell(file) - 1);
+                printf("ERROR: Unrecognized character '%s' at position %ld\n", printableByte((char)c).c_str(),
+                       in.offset() - 1);
                 exit(1);
             }
         }
     }
+    return false;
+}
+
+TokenCursor Lexer::tokens(const SourceBuffer& source, size_t from, Diagnostics* diagnostics,
+                          SymbolTable* symbols, pmr::memory_resource* memory) const {
+    return TokenCursor(*this, source, from, diagnostics, symbols, memory);
+}
+
+// Main lexing method
+TokenStream Lexer::lex(const SourceBuffer& source, Diagnostics* diagnostics, SymbolTable* symbols,
+                       pmr::memory_resource* memory) const {
+    TokenStream stream(source.begin(), memory);
+    TokenView token;
+    TokenCursor cursor(*this, source, 0, diagnostics, symbols, memory);
     
+    while (cursor.next(token)) {
+        stream.push(token);
+    }
+    
+    return stream;
+}
+
+TokenStream Lexer::lex(FILE* file) const {
+    SourceBuffer source;
+    if (!source.loadStream(file)) {
+        return TokenStream();
+    }
+    TokenStream tokens = lex(source);
+    tokens.adoptSource(std::move(source));
     return tokens;
 }
 
+// Token cursor
+
+TokenCursor::TokenCursor(const Lexer& lexer, const SourceBuffer& source, size_t from,
+                         Diagnostics* diagnostics, SymbolTable* symbols, pmr::memory_resource* memory)
+    : lexer(&lexer), in(source, from, memory), lookahead(memory) {
+    in.diagnostics = diagnostics;
+    in.symbols = symbols;
+}
+
+// Make sure at least count tokens are buffered; false if the input runs out
+bool TokenCursor::fill(size_t count) {
+    while (lookahead.size() < count) {
+        TokenView token;
+        if (!lexer->nextToken(in, token)) {
+            return false;
+        }
+        lookahead.push_back(Pending());
+        Pending& pending = lookahead.back();
+        pending.token = token;
+        // Unescaped literal text lives in the scratch buffer and would be
+        // overwritten by the next token
+        pending.ownsText = token.text.data() < in.begin || token.text.data() >= in.end;
+        if (pending.ownsText) {
+            pending.text.assign(token.text.data(), token.text.size());
+        }
+    }
+    return true;
+}
+
+bool TokenCursor::next(TokenView& token) {
+    if (lookahead.empty()) {
+        if (!lexer->nextToken(in, token)) {
+            return false;
+        }
+        // Unescaped literal text lives in the scratch buffer, which a later
+        // peek() would lex the next token into
+        if (token.text.data() < in.begin || token.text.data() >= in.end) {
+            current.assign(token.text.data(), token.text.size());
+            token.text = current;
+        }
+        return true;
+    }
+    
+    Pending& pending = lookahead.front();
+    token = pending.token;
+    if (pending.ownsText) {
+        current.swap(pending.text);
+        token.text = current;
+    }
+    lookahead.pop_front();
+    return true;
+}
+
+const TokenView* TokenCursor::peek(size_t k) {
+    if (!fill(k + 1)) {
+        return nullptr;
+    }
+    Pending& pending = lookahead[k];
+    if (pending.ownsText) {
+        pending.token.text = pending.text;
+    }
+    return &pending.token;
+}
+
 // Utility functions
 FILE* read_file(const char* filename) {
     FILE* file = fopen(filename, "r");
     if (file == NULL) {
-        perror("Error opening file");
+        fprintf(stderr, "Error opening file %s: %s\n", filename, strerror(errno));
         return NULL;
     }
     return file;
 }
 
-vector<Token*> lex_file(const char* filename, LexerMode mode) {
-    FILE* file = read_file(filename);
-    if (file == NULL) {
-        return vector<Token*>();
+bool read_file(const char* filename, SourceBuffer& source) {
+    return source.loadFile(filename);
+}
+
+TokenStream lex_file(const char* filename, LexerMode mode, TokenCache* cache) {
+    SourceBuffer source;
+    if (!read_file(filename, source)) {
+        return TokenStream();
     }
-    
-    Lexer lexer(mode);
-    vector<Token*> tokens = lexer.lex(file);
-    fclose(file);
+    TokenStream tokens = lex_file(source, mode, cache);
+    tokens.adoptSource(std::move(source));
     return tokens;
-}
\ No newline at end of file
+}
+
+TokenStream lex_file(const SourceBuffer& source, LexerMode mode, TokenCache* cache) {
+    Lexer lexer(mode);
+    return cache != nullptr ? cache->lex(lexer, source) : lexer.lex(source);
+}
@@ -0,0 +1,41 @@
+#include "include/lexicon.h"
+#include "include/dfa.h"
+
+using namespace std;
+
+map<string, int8_t> lexiconStateTags() {
+    map<string, int8_t> tags;
+    tags["S_ID"] = IDENTIFIER;
+    tags["S_NUM"] = NUMBER;
+
+    tags["S_CHAR_LITERAL"] = CHAR_LITERAL;
+    tags["S_SINGLE_CHAR"] = CHAR_LITERAL;
+
+    tags["S_STRING_LITERAL"] = STRING_LITERAL;
+    tags["S_STR_END"] = STRING_LITERAL;
+    tags["S_SEMICOLON"] = SEMICOLON;
+    tags["S_COMMA"] = COMMA;
+    tags["S_COLON_TEMP"] = COLON;
+    tags["S_DOT_TEMP"] = DOT;
+    tags["S_LPARENTHESIS"] = LPARENTHESIS;
+    tags["S_LPAREN_TEMP"] = LPARENTHESIS;
+    tags["S_RPARENTHESIS"] = RPARENTHESIS;
+    tags["S_LBRACKET"] = LBRACKET;
+    tags["S_RBRACKET"] = RBRACKET;
+    tags["S_PLUS"] = ARITHMETIC_OPERATOR;
+    tags["S_MINUS"] = ARITHMETIC_OPERATOR;
+    tags["S_MULTIPLY"] = ARITHMETIC_OPERATOR;
+    tags["S_DIVIDE"] = ARITHMETIC_OPERATOR;
+    tags["S_ASSIGN"] = ASSIGN_OPERATOR;
+    tags["S_EQ"] = RELATIONAL_OPERATOR;
+    tags["S_NE"] = RELATIONAL_OPERATOR;
+    tags["S_LT_TEMP"] = RELATIONAL_OPERATOR;
+    tags["S_LE"] = RELATIONAL_OPERATOR;
+    tags["S_GT_TEMP"] = RELATIONAL_OPERATOR;
+    tags["S_GE"] = RELATIONAL_OPERATOR;
+    tags["S_RANGE"] = RANGE_OPERATOR;
+
+    tags["S_COMMENT_SINGLE"] = STATE_COMMENT;
+    tags["S_COMMENT_MULTI"] = STATE_COMMENT;
+    return tags;
+}
@@ -1,21 +1,91 @@
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
+#include <cctype>
+#include <cerrno>
 #include <vector>
 #include <chrono>
+#include <memory>
+#include <unistd.h>
+#include <thread>
+#include <string>
+#include "include/arena.h"
 #include "include/lexer.h"
+#include "include/output.h"
+#include "include/batch.h"
+#include "include/chunked_lexer.h"
+#include "include/direct_lexer.h"
+#include "include/server.h"
+#include "include/token_cache.h"
 
 using namespace std;
 
+// Without --recover lexical errors exit(1); flush pending token output before stdio's
+// own buffers so the tokens come out ahead of the error message
+static OutputBuffer* pending_output = nullptr;
+
+static void flush_pending_output() {
+    if (pending_output != nullptr) {
+        pending_output->flush();
+    }
+}
+
 void print_usage(const char* program_name) {
-    cout << "Usage: " << program_name << " [options] <input_file>" << endl;
+    cout << "Usage: " << program_name << " [options] <input_file|directory>..." << endl;
     cout << "Options:" << endl;
     cout << "  -s, --switch    Use switch-based lexer instead of DFA" << endl;
+    cout << "  -d, --direct    Use the lexer generated from the rules at build time" << endl;
     cout << "  -l, --lexicon   Specify custom DFA rules file (default: rules/lexicon.dfa)" << endl;
     cout << "  -t, --time      Show timing information" << endl;
+    cout << "  -v, --verbose   Report how the DFA rules were compiled and count distinct identifiers" << endl;
+    cout << "  -p, --profile   Report DFA state visits, backtracks and phase timings (not with --split or --cache-dir)" << endl;
+    cout << "  --format=FMT    Token output format: text (default), jsonl, binary" << endl;
+    cout << "  -q, --quiet     Only count tokens, do not print them" << endl;
+    cout << "  -r, --recover   Keep lexing after errors and report them at the end" << endl;
+    cout << "  -j N            Lex multiple files on N threads (0 = all cores)" << endl;
+    cout << "  --read-ahead K  Read up to K files ahead of the lexing threads (default: 8, 0 = off)" << endl;
+    cout << "  --split N       Lex one large file as N chunks in parallel (0 = all cores)" << endl;
+    cout << "  --serve[=SOCK]  Stay resident and answer lex requests on stdin/stdout or a Unix socket" << endl;
+    cout << "  --cache-dir=DIR Reuse tokens of unchanged files from a cache in DIR (not with --split)" << endl;
+    cout << "  --cache-size=N  Cache size limit in bytes, K/M/G suffixes allowed (default: 256M)" << endl;
+    cout << "  --mem-stats     Report allocations of DFA tables and token storage, per phase" << endl;
+    cout << "  --compile-rules Write the DFA rules in binary form to <rules>.bin and exit" << endl;
     cout << "  -h, --help      Show this help message" << endl;
 }
 
+// Byte count such as 4096, 512K, 256M or 2G; false if malformed
+static bool parseSize(const char* text, uint64_t& size) {
+    char* suffix;
+    unsigned long long value = strtoull(text, &suffix, 10);
+    if (suffix == text) return false;
+    switch (toupper((unsigned char)*suffix)) {
+        case '\0': break;
+        case 'K': value <<= 10; suffix++; break;
+        case 'M': value <<= 20; suffix++; break;
+        case 'G': value <<= 30; suffix++; break;
+        default: return false;
+    }
+    size = value;
+    return *suffix == '\0';
+}
+
+// Decimal count no larger than max; false if malformed, negative or too large
+static bool parseCount(const char* text, size_t max, size_t& count) {
+    if (!isdigit((unsigned char)*text)) return false;
+    char* end;
+    errno = 0;
+    unsigned long value = strtoul(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || value > max) return false;
+    count = value;
+    return true;
+}
+
+// Upper bound of -j and --split; more threads than this is a typo
+static const size_t MAX_THREADS = 1024;
+
+// Upper bound of --read-ahead; the byte budget limits the window long before
+static const size_t MAX_READ_AHEAD = 65536;
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         print_usage(argv[0]);
@@ -24,13 +94,29 @@ int main(int argc, char* argv[]) {
     
     bool show_time = false;
     bool use_switch = false;
-    const char* input_file = nullptr;
+    bool use_direct = false;
+    bool compile_rules = false;
+    bool verbose = false;
+    bool recover = false;
+    bool serve = false;
+    bool profiling = false;
+    bool mem_stats = false;
+    string socket_path;
+    string cache_dir;
+    uint64_t cache_size = TokenCache::DEFAULT_MAX_BYTES;
+    OutputFormat format = TEXT_FORMAT;
+    vector<string> inputs;
+    size_t threads = 1;
+    size_t split = 1;
+    size_t read_ahead = 8;
     const char* dfa_rules_file = nullptr;
     
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--switch") == 0) {
             use_switch = true;
+        } else if (strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--direct") == 0) {
+            use_direct = true;
         } else if (strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--lexicon") == 0) {
             if (i + 1 >= argc) {
                 cout << "Option " << argv[i] << " requires an argument" << endl;
@@ -40,6 +126,72 @@ int main(int argc, char* argv[]) {
             dfa_rules_file = argv[++i];
         } else if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--time") == 0) {
             show_time = true;
+        } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (strcmp(argv[i], "-p") == 0 || strcmp(argv[i], "--profile") == 0) {
+            profiling = true;
+        } else if (strncmp(argv[i], "--format=", 9) == 0) {
+            if (!parseOutputFormat(argv[i] + 9, format)) {
+                cout << "Unknown output format: " << argv[i] + 9 << endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-j") == 0) {
+            if (i + 1 >= argc) {
+                cout << "Option " << argv[i] << " requires an argument" << endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            if (!parseCount(argv[++i], MAX_THREADS, threads)) {
+                cout << "Invalid thread count: " << argv[i] << endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            if (threads == 0) threads = thread::hardware_concurrency();
+        } else if (strcmp(argv[i], "--read-ahead") == 0) {
+            if (i + 1 >= argc) {
+                cout << "Option " << argv[i] << " requires an argument" << endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            if (!parseCount(argv[++i], MAX_READ_AHEAD, read_ahead)) {
+                cout << "Invalid read-ahead depth: " << argv[i] << endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--split") == 0) {
+            if (i + 1 >= argc) {
+                cout << "Option " << argv[i] << " requires an argument" << endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            if (!parseCount(argv[++i], MAX_THREADS, split)) {
+                cout << "Invalid chunk count: " << argv[i] << endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+            if (split == 0) split = thread::hardware_concurrency();
+        } else if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quiet") == 0) {
+            format = COUNT_FORMAT;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--recover") == 0) {
+            recover = true;
+        } else if (strcmp(argv[i], "--serve") == 0) {
+            serve = true;
+        } else if (strncmp(argv[i], "--serve=", 8) == 0) {
+            serve = true;
+            socket_path = argv[i] + 8;
+        } else if (strncmp(argv[i], "--cache-dir=", 12) == 0) {
+            cache_dir = argv[i] + 12;
+        } else if (strncmp(argv[i], "--cache-size=", 13) == 0) {
+            if (!parseSize(argv[i] + 13, cache_size)) {
+                cout << "Invalid cache size: " << argv[i] + 13 << endl;
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--mem-stats") == 0) {
+            mem_stats = true;
+        } else if (strcmp(argv[i], "--compile-rules") == 0) {
+            compile_rules = true;
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             print_usage(argv[0]);
             return 0;
@@ -48,56 +200,233 @@ int main(int argc, char* argv[]) {
             print_usage(argv[0]);
             return 1;
         } else {
-            if (input_file != nullptr) {
-                cout << "Multiple input files specified" << endl;
-                print_usage(argv[0]);
-                return 1;
-            }
-            input_file = argv[i];
+            inputs.push_back(argv[i]);
         }
     }
     
-    if (input_file == nullptr) {
+    // A cached file is never lexed, so it has nothing to split
+    if (split > 1 && !cache_dir.empty()) {
+        cout << "--split cannot be combined with --cache-dir" << endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    // The profile times one sequential pass, which neither of them runs
+    if (profiling && (split > 1 || !cache_dir.empty())) {
+        cout << "--profile cannot be combined with --split or --cache-dir" << endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    if (compile_rules) {
+        string rules = dfa_rules_file ? dfa_rules_file : "rules/pascal_lexicon.dfa";
+        string output = rules + ".bin";
+        Lexer lexer(DFA_MODE, rules);
+        if (!lexer.compileRules(output, rules)) {
+            cout << "Failed to compile rules: " << rules << endl;
+            return 1;
+        }
+        cout << "Compiled " << rules << " to " << output << endl;
+        lexer.getDFA().printStats(stdout);
+        return 0;
+    }
+    
+    LexerMode mode = use_direct ? DIRECT_MODE : use_switch ? SWITCH_MODE : DFA_MODE;
+    
+    // Server: stdout may carry the responses, so nothing else is printed there
+    if (serve) {
+        ServerOptions options;
+        if (socket_path.empty()) {
+            // Responses get a descriptor of their own; stray prints go to stderr
+            fflush(stdout);
+            options.output = dup(STDOUT_FILENO);
+            dup2(STDERR_FILENO, STDOUT_FILENO);
+        }
+        ReloadableLexer rules(mode, dfa_rules_file ? string(dfa_rules_file) : "rules/pascal_lexicon.dfa");
+        if (verbose && rules.getMode() == DFA_MODE) {
+            rules.latest()->getDFA().printStats(stderr);
+        }
+        options.format = format == COUNT_FORMAT ? TEXT_FORMAT : format;
+        options.threads = threads;
+        options.socketPath = socket_path;
+        return runServer(rules, options);
+    }
+    
+    if (inputs.empty()) {
         cout << "No input file specified" << endl;
         print_usage(argv[0]);
         return 1;
     }
     
+    vector<string> files;
+    if (!collectInputs(inputs, files)) {
+        return 1;
+    }
+    bool batch = inputs.size() > 1 || files.size() != 1 || files[0] != inputs[0];
+    const char* input_file = files.empty() ? inputs[0].c_str() : files[0].c_str();
+    
+    // Machine-readable formats keep stdout for the tokens alone
+    bool data_on_stdout = format == JSONL_FORMAT || format == BINARY_FORMAT;
+    ostream& info = data_on_stdout ? cerr : cout;
+    
     // Show which lexer mode is being used
-    cout << "Using " << (use_switch ? "switch-based" : "DFA-based") << " lexer" << endl;
-    if (!use_switch) {
-        cout << "DFA rules file: " << (dfa_rules_file ? dfa_rules_file : "rules/pascal_lexicon.dfa") << endl;
+    if (use_direct) {
+        info << "Using direct-coded lexer" << endl;
+        info << "DFA rules file: " << DIRECT_RULES_FILE << " (compiled in)" << endl;
+    } else {
+        info << "Using " << (use_switch ? "switch-based" : "DFA-based") << " lexer" << endl;
+        if (!use_switch) {
+            info << "DFA rules file: " << (dfa_rules_file ? dfa_rules_file : "rules/pascal_lexicon.dfa") << endl;
+        }
+    }
+    
+    unique_ptr<TokenCache> cache;
+    if (!cache_dir.empty()) {
+        cache.reset(new TokenCache(cache_dir, cache_size));
+        if (!cache->open()) {
+            info << "Cannot use cache directory: " << cache_dir << endl;
+            return 1;
+        }
     }
-    cout << "Processing file: " << input_file << endl;
-    cout << "----------------------------------------" << endl;
     
-    FILE* file = read_file(input_file);
-    if (file == NULL) {
-        cout << "Failed to open file: " << input_file << endl;
+    // With --mem-stats the DFA tables and token storage are allocated through
+    // a counter; output, diagnostics and symbols are not counted
+    CountingResource counted;
+    pmr::memory_resource* memory = mem_stats ? &counted : pmr::get_default_resource();
+    
+    // Several files or a directory: lex them in parallel on one shared Lexer
+    if (batch) {
+        Lexer lexer(mode, dfa_rules_file ? string(dfa_rules_file) : "rules/pascal_lexicon.dfa", memory);
+        MemoryUsage loaded = counted.usage();
+        if (verbose && mode == DFA_MODE) {
+            lexer.getDFA().printStats(stderr);
+        }
+        BatchOptions options;
+        options.format = format;
+        options.threads = threads;
+        options.recover = recover;
+        options.cache = cache.get();
+        options.readAhead = read_ahead;
+        if (mem_stats) {
+            options.memory = &counted;
+            info << "Memory (DFA tables and token storage):" << endl;
+            printMemoryPhase(info, "load", MemoryUsage(), loaded);
+            counted.resetPeak();
+        }
+        return runBatch(lexer, files, options);
+    }
+    
+    info << "Processing file: " << input_file << endl;
+    info << "----------------------------------------" << endl;
+    
+    SourceBuffer source;
+    if (!read_file(input_file, source)) {
+        info << "Failed to open file: " << input_file << endl;
         return 1;
     }
     
-    LexerMode mode = use_switch ? SWITCH_MODE : DFA_MODE;
-    Lexer lexer(mode, dfa_rules_file ? string(dfa_rules_file) : "rules/pascal_lexicon.dfa");
+    LexProfile profile;
+    auto load_start = std::chrono::steady_clock::now();
+    Lexer lexer(mode, dfa_rules_file ? string(dfa_rules_file) : "rules/pascal_lexicon.dfa", memory);
+    MemoryUsage loaded = counted.usage();
+    counted.resetPeak();
+    auto load_end = std::chrono::steady_clock::now();
+    if (verbose && mode == DFA_MODE) {
+        lexer.getDFA().printStats(stderr);
+    }
+    
+    fflush(stdout);
+    OutputBuffer output(STDOUT_FILENO);
+    unique_ptr<TokenWriter> writer = createTokenWriter(format, output);
+    writer->setSource(source.begin());
+    pending_output = &output;
+    atexit(flush_pending_output);
     
+    Diagnostics diagnostics;
+    // Interning costs a hash and a lock per identifier: only pay for it when
+    // the ids are written (jsonl) or the distinct count is shown (-v)
+    SymbolTable symbolTable;
+    SymbolTable* symbols = verbose || format == JSONL_FORMAT ? &symbolTable : nullptr;
     auto start_time = std::chrono::high_resolution_clock::now();
-    vector<Token*> tokens = lexer.lex(file);
+    size_t resume = 0;
+    if (profiling) {
+        // Lex everything before writing anything so the phases are timed apart
+        profile.reset(lexer.getMode() == DFA_MODE ? &lexer.getDFA() : nullptr);
+        profile.loadSeconds = std::chrono::duration<double>(load_end - load_start).count();
+        TokenStream stream(source.begin(), memory);
+        TokenCursor cursor = lexer.tokens(source, 0, recover ? &diagnostics : nullptr, symbols, memory);
+        cursor.setProfile(&profile);
+        TokenView token;
+        while (cursor.next(token)) {
+            stream.push(token);
+        }
+        auto lex_end = std::chrono::high_resolution_clock::now();
+        for (const TokenView& token : stream) {
+            profile.countToken(token.type);
+            writer->write(token);
+        }
+        profile.lexSeconds = std::chrono::duration<double>(lex_end - start_time).count();
+        resume = source.size();
+    } else if (cache) {
+        // A hit decodes the stored tokens; only a miss is lexed
+        TokenStream cached = cache->lex(lexer, source, recover ? &diagnostics : nullptr, symbols, memory);
+        for (const TokenView& token : cached) {
+            writer->write(token);
+        }
+        resume = source.size();
+    } else if (split > 1 && mode != SWITCH_MODE) {
+        TokenStream chunked(source.begin(), memory);
+        resume = lexChunked(lexer, source, split, chunked, symbols);
+        for (const TokenView& token : chunked) {
+            writer->write(token);
+        }
+    }
+    // Whatever the chunked pass left, an error included, is lexed sequentially
+    for (const TokenView& token : lexer.tokens(source, resume, recover ? &diagnostics : nullptr, symbols, memory)) {
+        writer->write(token);
+    }
+    writer->finish();
+    output.flush();
     auto end_time = std::chrono::high_resolution_clock::now();
+    if (profiling) {
+        profile.outputSeconds = std::chrono::duration<double>(end_time - start_time).count() - profile.lexSeconds;
+    }
     
-    cout << "----------------------------------------" << endl;
-    cout << "Tokenization completed successfully!" << endl;
-    cout << "Total tokens: " << tokens.size() << endl;
+    info << "----------------------------------------" << endl;
+    if (diagnostics.empty()) {
+        info << "Tokenization completed successfully!" << endl;
+    } else {
+        diagnostics.locate(source.begin(), source.size());
+        for (const Diagnostic& diagnostic : diagnostics) {
+            info << diagnostic.message(source.begin()) << endl;
+        }
+        info << "Tokenization completed with " << diagnostics.size() << " error(s)" << endl;
+    }
+    info << "Total tokens: " << writer->getCount() << endl;
+    if (verbose) {
+        info << "Distinct identifiers: " << symbolTable.size() << endl;
+    }
+    if (cache) {
+        cache->printStats(info);
+    }
+    if (mem_stats) {
+        info << "Memory (DFA tables and token storage):" << endl;
+        printMemoryPhase(info, "load", MemoryUsage(), loaded);
+        printMemoryPhase(info, "lex", loaded, counted.usage());
+    }
     
     if (show_time) {
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-        cout << "Lexical analysis completed in " << duration.count() << " microseconds ("
+        info << "Lexical analysis completed in " << duration.count() << " microseconds ("
              << duration.count() / 1000.0 << " milliseconds)" << endl;
     }
     
-    // Cleanup
-    for (Token* token : tokens) {
-        delete token;
+    if (profiling) {
+        profile.print(stderr, lexer.getMode() == DFA_MODE ? &lexer.getDFA() : nullptr);
     }
     
-    return 0;
+    pending_output = nullptr;
+    if (outputFailed(output)) {
+        return 1;
+    }
+    return diagnostics.empty() ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <new>
+#include <unistd.h>
+
+#include "include/output.h"
+#include "include/scan.h"
+
+using namespace std;
+
+bool parseOutputFormat(const string& name, OutputFormat& format) {
+    if (name == "text") {
+        format = TEXT_FORMAT;
+    } else if (name == "jsonl") {
+        format = JSONL_FORMAT;
+    } else if (name == "binary") {
+        format = BINARY_FORMAT;
+    } else if (name == "count") {
+        format = COUNT_FORMAT;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Output buffer
+
+OutputBuffer::OutputBuffer(int fd, size_t capacity) : fd(fd), data(nullptr), size(0), capacity(0), error(0) {
+    reserve(capacity);
+}
+
+OutputBuffer::~OutputBuffer() {
+    flush();
+    free(data);
+}
+
+void OutputBuffer::reserve(size_t needed) {
+    if (needed <= capacity) return;
+    size_t grown = capacity < 4096 ? 4096 : capacity;
+    while (grown < needed) grown *= 2;
+    char* bigger = (char*)realloc(data, grown);
+    if (bigger == nullptr) throw bad_alloc();
+    data = bigger;
+    capacity = grown;
+}
+
+void OutputBuffer::writeAll(const char* bytes, size_t length) {
+    while (length > 0 && error == 0) {
+        ssize_t n = ::write(fd, bytes, length);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            error = n < 0 ? errno : EIO;
+            return;
+        }
+        bytes += n;
+        length -= (size_t)n;
+    }
+}
+
+bool outputFailed(const OutputBuffer& out) {
+    cout.flush();
+    if (out.writeError() == 0 && !cout.fail()) return false;
+    cerr << "Error writing output: " << (out.writeError() != 0 ? strerror(out.writeError()) : "write failed") << endl;
+    return true;
+}
+
+void OutputBuffer::makeRoom(size_t length) {
+    if (fd >= 0) {
+        flush();
+    } else {
+        reserve(size + length);
+    }
+}
+
+void OutputBuffer::flush() {
+    if (fd < 0 || size == 0) return;
+    writeAll(data, size);
+    size = 0;
+}
+
+// Writers
+
+static size_t typeNameLength(Type type) {
+    struct Lengths {
+        size_t values[ERROR_TOKEN + 1];
+        Lengths() {
+            for (int t = 0; t <= ERROR_TOKEN; t++) values[t] = strlen(typeToString((Type)t));
+        }
+    };
+    static const Lengths lengths;
+    return lengths.values[type];
+}
+
+static void appendNumber(OutputBuffer& out, uint32_t value) {
+    char digits[10];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (n > 0) out.append(digits[--n]);
+}
+
+void TextTokenWriter::write(const TokenView& token) {
+    out.append(typeToString(token.type), typeNameLength(token.type));
+    out.append('(');
+    out.append(token.text.data(), token.text.size());
+    out.append(")\n", 2);
+    count++;
+}
+
+void appendJsonString(OutputBuffer& out, string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+    out.append('"');
+    size_t run = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c >= 0x80) {
+            // Well-formed UTF-8 passes through; any other byte would make
+            // the line invalid JSON and becomes U+FFFD
+            size_t length = utf8SequenceLength(text.data() + i, text.data() + text.size());
+            if (length > 0) {
+                i += length - 1;
+                continue;
+            }
+            out.append(text.data() + run, i - run);
+            run = i + 1;
+            out.append("\\ufffd", 6);
+            continue;
+        }
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        out.append(text.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+            case '"': out.append("\\\"", 2); break;
+            case '\\': out.append("\\\\", 2); break;
+            case '\n': out.append("\\n", 2); break;
+            case '\t': out.append("\\t", 2); break;
+            case '\r': out.append("\\r", 2); break;
+            default: {
+                char escape[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 15]};
+                out.append(escape, sizeof(escape));
+            }
+        }
+    }
+    out.append(text.data() + run, text.size() - run);
+    out.append('"');
+}
+
+void JsonlTokenWriter::write(const TokenView& token) {
+    out.append("{\"type\":\"", 9);
+    out.append(typeToString(token.type), typeNameLength(token.type));
+    out.append("\",\"value\":", 10);
+    appendJsonString(out, token.text);
+    out.append(",\"offset\":", 10);
+    appendNumber(out, token.offset);
+    out.append(",\"length\":", 10);
+    appendNumber(out, token.length);
+    if (source != nullptr) {
+        if (token.offset < bytesSeen) {
+            bytesSeen = codePointsSeen = 0;
+        }
+        codePointsSeen += (uint32_t)countCodePoints(source + bytesSeen, source + token.offset);
+        uint32_t codePoints = (uint32_t)countCodePoints(source + token.offset, source + token.offset + token.length);
+        out.append(",\"cp_offset\":", 13);
+        appendNumber(out, codePointsSeen);
+        out.append(",\"cp_length\":", 13);
+        appendNumber(out, codePoints);
+        bytesSeen = token.offset + token.length;
+        codePointsSeen += codePoints;
+    }
+    if (token.symbol != NO_SYMBOL) {
+        out.append(",\"symbol\":", 10);
+        appendNumber(out, token.symbol);
+    }
+    out.append("}\n", 2);
+    count++;
+}
+
+BinaryTokenWriter::BinaryTokenWriter(OutputBuffer& out) : TokenWriter(out), headerAt(out.length()) {
+    uint32_t version = BINARY_TOKENS_VERSION;
+    uint32_t records = 0;
+    out.append("PSTOKENS", 8);
+    out.append((const char*)&version, sizeof(version));
+    out.append((const char*)&records, sizeof(records));
+}
+
+void BinaryTokenWriter::finish() {
+    if (out.inMemory()) {
+        uint32_t records = (uint32_t)count;
+        out.patch(headerAt + 12, &records, sizeof(records));
+    }
+}
+
+void BinaryTokenWriter::write(const TokenView& token) {
+    struct {
+        uint32_t offset;
+        uint32_t length;
+        uint32_t value_length;
+        uint8_t type;
+        uint8_t padding[3];
+    } record = {token.offset, token.length, (uint32_t)token.text.size(), (uint8_t)token.type, {0, 0, 0}};
+    static const char ZEROS[4] = {0, 0, 0, 0};
+
+    out.append((const char*)&record, sizeof(record));
+    out.append(token.text.data(), token.text.size());
+    out.append(ZEROS, (4 - token.text.size() % 4) % 4);
+    count++;
+}
+
+unique_ptr<TokenWriter> createTokenWriter(OutputFormat format, OutputBuffer& out) {
+    switch (format) {
+        case JSONL_FORMAT: return unique_ptr<TokenWriter>(new JsonlTokenWriter(out));
+        case BINARY_FORMAT: return unique_ptr<TokenWriter>(new BinaryTokenWriter(out));
+        case COUNT_FORMAT: return unique_ptr<TokenWriter>(new CountTokenWriter(out));
+        default: return unique_ptr<TokenWriter>(new TextTokenWriter(out));
+    }
+}
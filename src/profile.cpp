@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <utility>
+
+#include "include/profile.h"
+#include "include/dfa.h"
+
+using namespace std;
+
+// Rows printed for the busiest states and transitions
+static const size_t PROFILE_TOP = 10;
+
+void LexProfile::reset(const DFA* dfa) {
+    *this = LexProfile();
+    states = dfa != nullptr ? dfa->getStateCount() : 0;
+    stateVisits.assign(states, 0);
+    transitions.assign(states * states, 0);
+}
+
+void LexProfile::print(FILE* out, const DFA* dfa) const {
+    fprintf(out, "Profile\n");
+    fprintf(out, "  Phases: load %.3f ms, lex %.3f ms, output %.3f ms\n",
+            loadSeconds * 1000.0, lexSeconds * 1000.0, outputSeconds * 1000.0);
+    fprintf(out, "  Lexemes: %llu, backtracks: %llu (%llu bytes rescanned)\n",
+            (unsigned long long)lexemes, (unsigned long long)backtracks, (unsigned long long)rescannedBytes);
+    fprintf(out, "  Bytes in comments: %llu, in literals: %llu\n",
+            (unsigned long long)commentBytes, (unsigned long long)literalBytes);
+
+    fprintf(out, "  Tokens by type:\n");
+    for (int t = 0; t <= ERROR_TOKEN; t++) {
+        if (tokens[t] != 0) {
+            fprintf(out, "    %-20s %llu\n", typeToString((Type)t), (unsigned long long)tokens[t]);
+        }
+    }
+
+    if (states == 0 || dfa == nullptr) {
+        return;
+    }
+
+    vector<pair<uint64_t, size_t>> busy;
+    for (size_t s = 0; s < states; s++) {
+        if (stateVisits[s] != 0) busy.push_back(make_pair(stateVisits[s], s));
+    }
+    sort(busy.rbegin(), busy.rend());
+    fprintf(out, "  State visits (%zu of %zu states used):\n", busy.size(), states);
+    for (size_t i = 0; i < busy.size() && i < PROFILE_TOP; i++) {
+        fprintf(out, "    %-30s %llu\n", dfa->getStateName((uint16_t)busy[i].second).c_str(),
+                (unsigned long long)busy[i].first);
+    }
+
+    busy.clear();
+    for (size_t i = 0; i < transitions.size(); i++) {
+        if (transitions[i] != 0) busy.push_back(make_pair(transitions[i], i));
+    }
+    sort(busy.rbegin(), busy.rend());
+    fprintf(out, "  Transitions (%zu distinct):\n", busy.size());
+    for (size_t i = 0; i < busy.size() && i < PROFILE_TOP; i++) {
+        size_t from = busy[i].second / states;
+        size_t to = busy[i].second % states;
+        fprintf(out, "    %s -> %s  %llu\n", dfa->getStateName((uint16_t)from).c_str(),
+                dfa->getStateName((uint16_t)to).c_str(), (unsigned long long)busy[i].first);
+    }
+}
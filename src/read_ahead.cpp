@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define READ_AHEAD_URING 1
+#endif
+
+#include "include/read_ahead.h"
+
+using namespace std;
+
+// Largest single read request; longer files take several
+static const size_t MAX_READ = 1u << 30;
+
+#ifdef READ_AHEAD_URING
+
+// Minimal io_uring driven through the raw system calls: one submitter and
+// one reaper (the I/O thread), reads only
+struct ReadAhead::Ring {
+    int fd = -1;
+    void* sqMap = MAP_FAILED;
+    size_t sqMapSize = 0;
+    void* cqMap = MAP_FAILED;
+    size_t cqMapSize = 0;
+    io_uring_sqe* sqes = (io_uring_sqe*)MAP_FAILED;
+    size_t sqesSize = 0;
+
+    unsigned* sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    bool setup(unsigned entries) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0) return false;
+
+        sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) {
+            sqMapSize = cqMapSize = max(sqMapSize, cqMapSize);
+        }
+        sqMap = mmap(nullptr, sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sqMap == MAP_FAILED) return false;
+        if (!single) {
+            cqMap = mmap(nullptr, cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (cqMap == MAP_FAILED) return false;
+        }
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = (io_uring_sqe*)mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                                   IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+
+        char* sq = (char*)sqMap;
+        char* cq = single ? sq : (char*)cqMap;
+        sqTail = (unsigned*)(sq + params.sq_off.tail);
+        sqMask = *(unsigned*)(sq + params.sq_off.ring_mask);
+        sqArray = (unsigned*)(sq + params.sq_off.array);
+        cqHead = (unsigned*)(cq + params.cq_off.head);
+        cqTail = (unsigned*)(cq + params.cq_off.tail);
+        cqMask = *(unsigned*)(cq + params.cq_off.ring_mask);
+        cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    ~Ring() {
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (cqMap != MAP_FAILED) munmap(cqMap, cqMapSize);
+        if (sqMap != MAP_FAILED) munmap(sqMap, sqMapSize);
+        if (fd >= 0) close(fd);
+    }
+
+    // Queue and submit one read; the ring has a slot for every read in flight
+    bool submitRead(int file, char* into, size_t length, uint64_t offset, uint64_t tag) {
+        unsigned tail = *sqTail;
+        unsigned index = tail & sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = file;
+        sqe.addr = (uint64_t)(uintptr_t)into;
+        sqe.len = (uint32_t)min(length, MAX_READ);
+        sqe.off = offset;
+        sqe.user_data = tag;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        while (syscall(__NR_io_uring_enter, fd, 1, 0, 0, nullptr, 0) < 0) {
+            if (errno != EINTR && errno != EAGAIN) return false;
+        }
+        return true;
+    }
+
+    // Wait for the next completion
+    bool wait(uint64_t& tag, int& result) {
+        for (;;) {
+            unsigned head = *cqHead;
+            if (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& cqe = cqes[head & cqMask];
+                tag = cqe.user_data;
+                result = cqe.res;
+                __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+            if (syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR) {
+                return false;
+            }
+        }
+    }
+};
+
+#else
+
+struct ReadAhead::Ring {
+    bool setup(unsigned) { return false; }
+};
+
+#endif
+
+ReadAhead::ReadAhead(const vector<string>& files, size_t depth, size_t budget)
+    : files(files), depth(max<size_t>(depth, 1)), budget(budget), entries(files.size()) {
+    ring.reset(new Ring());
+    if (!ring->setup((unsigned)this->depth)) {
+        ring.reset();
+    }
+    worker = thread([this] {
+        if (ring) {
+            uringLoop();
+        } else {
+            readLoop(0);
+        }
+    });
+}
+
+ReadAhead::~ReadAhead() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    windowFreed.notify_all();
+    worker.join();
+}
+
+// Count a file of size bytes into the window if it fits. A file always
+// fits into an empty window, however large. With wait, blocks until it
+// fits; false only when stopping.
+bool ReadAhead::admit(size_t index, size_t size, bool wait) {
+    unique_lock<mutex> guard(lock);
+    auto fits = [&] { return held == 0 || (held < depth && heldBytes + size <= budget); };
+    if (wait) {
+        windowFreed.wait(guard, [&] { return stopping || fits(); });
+    }
+    if (stopping || !fits()) return false;
+    held++;
+    heldBytes += size;
+    entries[index].counted = true;
+    entries[index].reserved = size;
+    return true;
+}
+
+// Smallest free buffer that holds size bytes plus a terminator, else a
+// free one grown to fit, else a new one
+ReadAhead::Buffer ReadAhead::acquireBuffer(size_t size) {
+    lock_guard<mutex> guard(lock);
+    size_t needed = size + 1;
+    auto best = freeBuffers.end();
+    for (auto it = freeBuffers.begin(); it != freeBuffers.end(); ++it) {
+        if (it->capacity >= needed && (best == freeBuffers.end() || it->capacity < best->capacity)) {
+            best = it;
+        }
+    }
+    if (best == freeBuffers.end() && !freeBuffers.empty()) {
+        best = freeBuffers.begin();
+    }
+
+    Buffer buffer;
+    if (best != freeBuffers.end()) {
+        freeBytes -= best->capacity;
+        buffer = move(*best);
+        freeBuffers.erase(best);
+    }
+    if (buffer.capacity < needed) {
+        buffer.capacity = max(needed, buffer.capacity * 2);
+        buffer.bytes.reset(new char[buffer.capacity]);
+    }
+    return buffer;
+}
+
+// Pool a buffer that is no longer used, then free the largest pooled ones
+// while the pool holds more than budget bytes. Caller holds lock.
+void ReadAhead::recycle(Buffer&& buffer) {
+    freeBytes += buffer.capacity;
+    freeBuffers.push_back(move(buffer));
+    while (freeBytes > budget) {
+        auto largest = max_element(freeBuffers.begin(), freeBuffers.end(),
+                                   [](const Buffer& a, const Buffer& b) { return a.capacity < b.capacity; });
+        freeBytes -= largest->capacity;
+        freeBuffers.erase(largest);
+    }
+}
+
+// Read fd to its end, expecting expected bytes (0 when the size is unknown)
+bool ReadAhead::readPlain(int fd, size_t expected, Buffer& buffer, size_t& length) {
+    length = 0;
+    for (;;) {
+        if (expected > 0 && length == expected) return true;
+        if (length + 1 >= buffer.capacity) {
+            size_t capacity = max<size_t>(expected + 1, max<size_t>(buffer.capacity * 2, 1 << 16));
+            unique_ptr<char[]> grown(new char[capacity]);
+            if (length > 0) memcpy(grown.get(), buffer.bytes.get(), length);
+            buffer.bytes = move(grown);
+            buffer.capacity = capacity;
+        }
+        ssize_t n = read(fd, buffer.bytes.get() + length, buffer.capacity - 1 - length);
+        if (n == 0) return true;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        length += (size_t)n;
+    }
+}
+
+// error is 0 if the file was read, else the errno of the failure
+void ReadAhead::finish(size_t index, Buffer&& buffer, size_t size, int error) {
+    bool ok = error == 0;
+    {
+        lock_guard<mutex> guard(lock);
+        Entry& entry = entries[index];
+        entry.error = error;
+        if (ok) {
+            buffer.bytes[size] = '\0';
+            entry.buffer = move(buffer);
+            entry.size = size;
+        } else if (buffer.bytes) {
+            recycle(move(buffer));
+        }
+        entry.state = ok ? READY : FAILED;
+    }
+    entryReady.notify_all();
+}
+
+// Fallback: one file at a time with blocking reads, from file first on
+void ReadAhead::readLoop(size_t first) {
+    for (size_t index = first; index < files.size(); index++) {
+        int fd = open(files[index].c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            int error = errno;
+            if (fd >= 0) close(fd);
+            finish(index, Buffer(), 0, error);
+            continue;
+        }
+        size_t expected = S_ISREG(st.st_mode) ? (size_t)st.st_size : 0;
+        if (!admit(index, expected, true)) {
+            close(fd);
+            return;
+        }
+        Buffer buffer = acquireBuffer(expected);
+        size_t length;
+        int error = readPlain(fd, expected, buffer, length) ? 0 : errno;
+        close(fd);
+        finish(index, move(buffer), length, error);
+    }
+}
+
+#ifdef READ_AHEAD_URING
+
+// io_uring: open files in order and keep the whole window's reads in flight
+void ReadAhead::uringLoop() {
+    struct Read {
+        size_t index;
+        int fd;
+        Buffer buffer;
+        size_t size;
+        size_t done;
+    };
+    vector<Read> reads(depth);
+    vector<size_t> freeSlots;
+    for (size_t slot = depth; slot-- > 0;) {
+        freeSlots.push_back(slot);
+    }
+
+    size_t next = 0;
+    int pendingFd = -1;         // opened next file, waiting for room in the window
+    size_t pendingSize = 0;
+    bool pendingPlain = false;  // a pipe or other file without a size
+    bool stopped = false;
+    for (;;) {
+        while (!stopped && next < files.size() && !freeSlots.empty()) {
+            if (pendingFd < 0) {
+                int fd = open(files[next].c_str(), O_RDONLY | O_CLOEXEC);
+                struct stat st;
+                if (fd < 0 || fstat(fd, &st) != 0) {
+                    int error = errno;
+                    if (fd >= 0) close(fd);
+                    finish(next++, Buffer(), 0, error);
+                    continue;
+                }
+                pendingFd = fd;
+                pendingPlain = !S_ISREG(st.st_mode);
+                pendingSize = pendingPlain ? 0 : (size_t)st.st_size;
+            }
+
+            // Only block for room when no read is in flight to free some
+            bool idle = freeSlots.size() == depth;
+            if (!admit(next, pendingSize, idle)) {
+                stopped = idle;
+                break;
+            }
+            Buffer buffer = acquireBuffer(pendingSize);
+            if (pendingPlain || pendingSize == 0) {
+                size_t length = 0;
+                bool ok = pendingSize == 0 && !pendingPlain ? true : readPlain(pendingFd, 0, buffer, length);
+                int error = ok ? 0 : errno;
+                close(pendingFd);
+                pendingFd = -1;
+                finish(next++, move(buffer), length, error);
+                continue;
+            }
+            size_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            reads[slot] = Read{next++, pendingFd, move(buffer), pendingSize, 0};
+            pendingFd = -1;
+            Read& read = reads[slot];
+            if (!ring->submitRead(read.fd, read.buffer.bytes.get(), read.size, 0, slot)) {
+                size_t length;
+                int error = readPlain(read.fd, read.size, read.buffer, length) ? 0 : errno;
+                close(read.fd);
+                finish(read.index, move(read.buffer), length, error);
+                freeSlots.push_back(slot);
+            }
+        }
+
+        if (freeSlots.size() == depth) {
+            // Nothing in flight, so nothing was waiting on room either
+            if (stopped || next >= files.size()) break;
+            continue;
+        }
+
+        uint64_t tag;
+        int result;
+        if (!ring->wait(tag, result)) {
+            // Cannot reap any more: give up on the reads in flight, whose
+            // buffers the kernel may still write (so they are leaked), and
+            // read the rest of the files directly
+            for (size_t slot = 0; slot < depth; slot++) {
+                if (find(freeSlots.begin(), freeSlots.end(), slot) != freeSlots.end()) continue;
+                Read& read = reads[slot];
+                read.buffer.bytes.release();
+                close(read.fd);
+                finish(read.index, Buffer(), 0, EIO);
+            }
+            if (pendingFd >= 0) close(pendingFd);
+            readLoop(next);
+            return;
+        }
+        Read& read = reads[tag];
+        if (result == -EINTR || result == -EAGAIN) {
+            result = 0;         // resubmitted below
+        } else if (result < 0) {
+            close(read.fd);
+            finish(read.index, move(read.buffer), 0, -result);
+            freeSlots.push_back(tag);
+            continue;
+        } else if (result == 0) {
+            // The file shrank since fstat: keep what was read
+            read.size = read.done;
+        }
+        read.done += (size_t)result;
+        if (read.done < read.size &&
+            ring->submitRead(read.fd, read.buffer.bytes.get() + read.done, read.size - read.done, read.done, tag)) {
+            continue;
+        }
+        close(read.fd);
+        finish(read.index, move(read.buffer), read.done, read.done >= read.size ? 0 : EIO);
+        freeSlots.push_back(tag);
+    }
+    if (pendingFd >= 0) {
+        close(pendingFd);
+    }
+}
+
+#else
+
+void ReadAhead::uringLoop() {
+    readLoop(0);
+}
+
+#endif
+
+bool ReadAhead::take(PrefetchedFile& file) {
+    unique_lock<mutex> guard(lock);
+    if (taken >= files.size()) return false;
+    size_t index = taken++;
+    Entry& entry = entries[index];
+    entryReady.wait(guard, [&] { return entry.state != WAITING; });
+    file.index = index;
+    file.ok = entry.state == READY;
+    file.error = entry.error;
+    file.data = file.ok ? entry.buffer.bytes.get() : "";
+    file.size = file.ok ? entry.size : 0;
+    return true;
+}
+
+void ReadAhead::release(const PrefetchedFile& file) {
+    {
+        lock_guard<mutex> guard(lock);
+        Entry& entry = entries[file.index];
+        if (entry.buffer.bytes) {
+            recycle(move(entry.buffer));
+        }
+        if (entry.counted) {
+            entry.counted = false;
+            held--;
+            heldBytes -= entry.reserved;
+        }
+    }
+    windowFreed.notify_all();
+}
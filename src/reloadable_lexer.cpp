@@ -0,0 +1,165 @@
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "include/reloadable_lexer.h"
+#include "include/lexicon.h"
+
+using namespace std;
+
+ReloadableLexer::ReloadableLexer(LexerMode mode, const string& rulesFile)
+    : mode(mode), rulesFile(rulesFile), current(make_shared<const Lexer>(mode, rulesFile)),
+      published(current.get()) {}
+
+bool ReloadableLexer::reload(string& error) {
+    if (mode == DIRECT_MODE) {
+        error = "direct mode has its rules compiled in";
+        return false;
+    }
+
+    // Build and validate outside the lock: readers keep the old snapshot meanwhile
+    DFA rules;
+    rules.setStateTagNames(lexiconStateTags());
+    if (!rules.loadRules(rulesFile)) {
+        error = "failed to load DFA rules from " + rulesFile;
+        return false;
+    }
+    shared_ptr<const Lexer> next = make_shared<const Lexer>(mode, move(rules));
+
+    shared_ptr<const Lexer> previous;
+    {
+        lock_guard<mutex> guard(lock);
+        previous = move(current);
+        current = move(next);
+        published.store(current.get(), memory_order_release);
+    }
+    // previous is released here, or by the last lex still running on it
+    return true;
+}
+
+shared_ptr<const Lexer> ReloadableLexer::snapshot() const {
+    lock_guard<mutex> guard(lock);
+    return current;
+}
+
+// Write end of the running watcher's self-pipe, for the SIGHUP handler
+static volatile sig_atomic_t hangupPipe = -1;
+
+static void onHangup(int) {
+    int saved = errno;
+    if (hangupPipe >= 0) {
+        char request = 'R';
+        ssize_t ignored = write(hangupPipe, &request, 1);
+        (void)ignored;
+    }
+    errno = saved;
+}
+
+RulesWatcher::RulesWatcher(ReloadableLexer& rules) : rules(rules) {}
+
+RulesWatcher::~RulesWatcher() {
+    stop();
+}
+
+void RulesWatcher::start() {
+    if (worker.joinable()) return;
+    if (pipe(wakeup) < 0) {
+        perror("pipe");
+        return;
+    }
+    fcntl(wakeup[0], F_SETFL, O_NONBLOCK);
+    fcntl(wakeup[1], F_SETFL, O_NONBLOCK);
+
+    // Watch the directory: editors and --compile-rules may replace the file
+    const string& file = rules.getRulesFile();
+    size_t slash = file.rfind('/');
+    string directory = slash == string::npos ? "." : slash == 0 ? "/" : file.substr(0, slash);
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd >= 0 && inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+    if (inotifyFd < 0) {
+        cerr << "Cannot watch " << directory << ", rules reload on SIGHUP only" << endl;
+    }
+
+    hangupPipe = wakeup[1];
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onHangup;
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGHUP, &action, nullptr);
+
+    worker = thread(&RulesWatcher::watchLoop, this);
+}
+
+void RulesWatcher::stop() {
+    if (worker.joinable()) {
+        char request = 'Q';
+        ssize_t ignored = write(wakeup[1], &request, 1);
+        (void)ignored;
+        worker.join();
+    }
+    hangupPipe = -1;
+    signal(SIGHUP, SIG_DFL);
+    for (int& fd : wakeup) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+    if (inotifyFd >= 0) close(inotifyFd);
+    inotifyFd = -1;
+}
+
+void RulesWatcher::watchLoop() {
+    const string& file = rules.getRulesFile();
+    size_t slash = file.rfind('/');
+    string name = slash == string::npos ? file : file.substr(slash + 1);
+    string compiledName = name + ".bin";
+
+    pollfd fds[2] = {{wakeup[0], POLLIN, 0}, {inotifyFd, POLLIN, 0}};
+    nfds_t count = inotifyFd >= 0 ? 2 : 1;
+    for (;;) {
+        if (poll(fds, count, -1) < 0) {
+            if (errno == EINTR) continue;
+            perror("poll");
+            return;
+        }
+
+        bool changed = false;
+        if (fds[0].revents & POLLIN) {
+            char requests[64];
+            ssize_t got;
+            while ((got = read(wakeup[0], requests, sizeof(requests))) > 0) {
+                if (memchr(requests, 'Q', got)) return;
+                changed = true;
+            }
+        }
+        if (count > 1 && (fds[1].revents & POLLIN)) {
+            alignas(inotify_event) char events[4096];
+            ssize_t got;
+            while ((got = read(inotifyFd, events, sizeof(events))) > 0) {
+                for (char* p = events; p < events + got;) {
+                    const inotify_event* event = (const inotify_event*)p;
+                    if (event->len > 0 && (name == event->name || compiledName == event->name)) {
+                        changed = true;
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+        }
+
+        if (changed) {
+            string error;
+            if (rules.reload(error)) {
+                cerr << "Reloaded rules from " << file << endl;
+            } else {
+                cerr << "Keeping previous rules: " << error << endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,291 @@
+#include "include/scan.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCAN_X86 1
+#endif
+
+using namespace std;
+
+static inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static inline bool isStop(const StopBytes& stops, char c) {
+    unsigned char u = (unsigned char)c;
+    if (c == stops.bytes[0] || c == stops.bytes[1] || c == stops.bytes[2] || u == 0x7f) return true;
+    if (u >= 0x80) return !stops.passHigh;
+    return u < 0x20 && c != stops.passes[0] && c != stops.passes[1] && c != stops.passes[2];
+}
+
+// Scalar versions, also used for the tail of the vector loops
+
+static const char* skipSpacesScalar(const char* p, const char* end) {
+    while (p < end && isSpace(*p)) p++;
+    return p;
+}
+
+static const char* findStopScalar(const StopBytes& stops, const char* p, const char* end) {
+    while (p < end && !isStop(stops, *p)) p++;
+    return p;
+}
+
+static const char* findByteScalar(const char* p, const char* end, char c) {
+    while (p < end && *p != c) p++;
+    return p;
+}
+
+#ifdef SCAN_X86
+
+__attribute__((target("sse2")))
+static const char* skipSpacesSse2(const char* p, const char* end) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(v, newline), _mm_cmpeq_epi8(v, cr)));
+        unsigned mask = ~(unsigned)_mm_movemask_epi8(ws) & 0xFFFF;
+        if (mask != 0) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+    return skipSpacesScalar(p, end);
+}
+
+__attribute__((target("sse2")))
+static const char* findStopSse2(const StopBytes& stops, const char* p, const char* end) {
+    const __m128i low = _mm_set1_epi8(0x20);
+    const __m128i del = _mm_set1_epi8(0x7f);
+    const __m128i a = _mm_set1_epi8(stops.bytes[0]);
+    const __m128i b = _mm_set1_epi8(stops.bytes[1]);
+    const __m128i c = _mm_set1_epi8(stops.bytes[2]);
+    const __m128i passA = _mm_set1_epi8(stops.passes[0]);
+    const __m128i passB = _mm_set1_epi8(stops.passes[1]);
+    const __m128i passC = _mm_set1_epi8(stops.passes[2]);
+    // Nothing is below -128, so without passHigh no byte is let through
+    const __m128i floor = _mm_set1_epi8(stops.passHigh ? 0 : -128);
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        // Signed compare: bytes >= 0x80 are negative and count as below 0x20
+        __m128i control = _mm_andnot_si128(_mm_cmplt_epi8(v, floor), _mm_cmplt_epi8(v, low));
+        __m128i passed = _mm_or_si128(_mm_cmpeq_epi8(v, passA),
+                                      _mm_or_si128(_mm_cmpeq_epi8(v, passB), _mm_cmpeq_epi8(v, passC)));
+        __m128i hit = _mm_or_si128(_mm_andnot_si128(passed, control), _mm_cmpeq_epi8(v, del));
+        hit = _mm_or_si128(hit, _mm_or_si128(_mm_cmpeq_epi8(v, a),
+                                             _mm_or_si128(_mm_cmpeq_epi8(v, b), _mm_cmpeq_epi8(v, c))));
+        unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+        if (mask != 0) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+    return findStopScalar(stops, p, end);
+}
+
+__attribute__((target("sse2")))
+static const char* findByteSse2(const char* p, const char* end, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        if (mask != 0) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+    return findByteScalar(p, end, c);
+}
+
+__attribute__((target("avx2")))
+static const char* skipSpacesAvx2(const char* p, const char* end) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(v, newline), _mm256_cmpeq_epi8(v, cr)));
+        unsigned mask = ~(unsigned)_mm256_movemask_epi8(ws);
+        if (mask != 0) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return skipSpacesSse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* findStopAvx2(const StopBytes& stops, const char* p, const char* end) {
+    const __m256i low = _mm256_set1_epi8(0x20);
+    const __m256i del = _mm256_set1_epi8(0x7f);
+    const __m256i a = _mm256_set1_epi8(stops.bytes[0]);
+    const __m256i b = _mm256_set1_epi8(stops.bytes[1]);
+    const __m256i c = _mm256_set1_epi8(stops.bytes[2]);
+    const __m256i passA = _mm256_set1_epi8(stops.passes[0]);
+    const __m256i passB = _mm256_set1_epi8(stops.passes[1]);
+    const __m256i passC = _mm256_set1_epi8(stops.passes[2]);
+    const __m256i floor = _mm256_set1_epi8(stops.passHigh ? 0 : -128);
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i control = _mm256_andnot_si256(_mm256_cmpgt_epi8(floor, v), _mm256_cmpgt_epi8(low, v));
+        __m256i passed = _mm256_or_si256(_mm256_cmpeq_epi8(v, passA),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(v, passB), _mm256_cmpeq_epi8(v, passC)));
+        __m256i hit = _mm256_or_si256(_mm256_andnot_si256(passed, control), _mm256_cmpeq_epi8(v, del));
+        hit = _mm256_or_si256(hit, _mm256_or_si256(_mm256_cmpeq_epi8(v, a),
+                                                   _mm256_or_si256(_mm256_cmpeq_epi8(v, b), _mm256_cmpeq_epi8(v, c))));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(hit);
+        if (mask != 0) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return findStopSse2(stops, p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* findByteAvx2(const char* p, const char* end, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle));
+        if (mask != 0) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return findByteSse2(p, end, c);
+}
+
+#endif // SCAN_X86
+
+// Start out scalar (constant-initialised, so safe during static init) and
+// upgrade once the CPU has been checked
+static const char* (*skipSpacesImpl)(const char*, const char*) = skipSpacesScalar;
+static const char* (*findStopImpl)(const StopBytes&, const char*, const char*) = findStopScalar;
+static const char* (*findByteImpl)(const char*, const char*, char) = findByteScalar;
+static const char* level = "scalar";
+
+static bool selectScanners() {
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        skipSpacesImpl = skipSpacesAvx2;
+        findStopImpl = findStopAvx2;
+        findByteImpl = findByteAvx2;
+        level = "avx2";
+    } else if (__builtin_cpu_supports("sse2")) {
+        skipSpacesImpl = skipSpacesSse2;
+        findStopImpl = findStopSse2;
+        findByteImpl = findByteSse2;
+        level = "sse2";
+    }
+#endif
+    return true;
+}
+
+static bool scannersSelected = selectScanners();
+
+const char* skipSpaces(const char* p, const char* end) {
+    // Most gaps between tokens are a single byte, not worth a vector load
+    if (p >= end || !isSpace(*p)) return p;
+    p++;
+    if (p >= end || !isSpace(*p)) return p;
+    return skipSpacesImpl(p, end);
+}
+
+const char* findStop(const StopBytes& stops, const char* p, const char* end) {
+    return findStopImpl(stops, p, end);
+}
+
+const char* findByte(const char* p, const char* end, char c) {
+    return findByteImpl(p, end, c);
+}
+
+size_t countCodePoints(const char* p, const char* end) {
+    // Simple enough for the compiler to vectorise
+    size_t count = 0;
+    for (; p < end; p++) {
+        count += ((unsigned char)*p & 0xC0) != 0x80;
+    }
+    return count;
+}
+
+size_t utf8SequenceLength(const char* p, const char* end) {
+    const unsigned char* s = (const unsigned char*)p;
+    size_t available = (size_t)(end - p);
+    if (available == 0) return 0;
+    unsigned char lead = s[0];
+    if (lead < 0x80) return 1;
+
+    // Allowed range of the second byte per lead byte, as in RFC 3629
+    size_t length;
+    unsigned char low = 0x80, high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) low = 0xA0;
+        if (lead == 0xED) high = 0x9F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) low = 0x90;
+        if (lead == 0xF4) high = 0x8F;
+    } else {
+        return 0;
+    }
+    if (available < length || s[1] < low || s[1] > high) return 0;
+    for (size_t i = 2; i < length; i++) {
+        if ((s[i] & 0xC0) != 0x80) return 0;
+    }
+    return length;
+}
+
+static const uint64_t HASH_PRIME1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t HASH_PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t HASH_PRIME3 = 0x165667B19E3779F9ULL;
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t hashRound(uint64_t acc, uint64_t input) {
+    return rotl64(acc + input * HASH_PRIME2, 31) * HASH_PRIME1;
+}
+
+static inline uint64_t load64(const unsigned char* p) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    // Four independent lanes over 32-byte blocks keep the multipliers busy
+    const unsigned char* p = (const unsigned char*)data;
+    const unsigned char* end = p + size;
+    uint64_t h;
+    if (size >= 32) {
+        uint64_t lanes[4] = {seed + HASH_PRIME1 + HASH_PRIME2, seed + HASH_PRIME2, seed, seed - HASH_PRIME1};
+        for (; p + 32 <= end; p += 32) {
+            for (int i = 0; i < 4; i++) {
+                lanes[i] = hashRound(lanes[i], load64(p + 8 * i));
+            }
+        }
+        h = rotl64(lanes[0], 1) + rotl64(lanes[1], 7) + rotl64(lanes[2], 12) + rotl64(lanes[3], 18);
+        for (uint64_t lane : lanes) {
+            h = (h ^ hashRound(0, lane)) * HASH_PRIME1 + HASH_PRIME3;
+        }
+    } else {
+        h = seed + HASH_PRIME3;
+    }
+    h += size;
+    for (; p + 8 <= end; p += 8) {
+        h = rotl64(h ^ hashRound(0, load64(p)), 27) * HASH_PRIME1 + HASH_PRIME3;
+    }
+    for (; p < end; p++) {
+        h = rotl64(h ^ (*p * HASH_PRIME3), 11) * HASH_PRIME1;
+    }
+    h ^= h >> 33;
+    h *= HASH_PRIME2;
+    h ^= h >> 29;
+    h *= HASH_PRIME3;
+    return h ^ (h >> 32);
+}
+
+const char* scanLevel() {
+    (void)scannersSelected;
+    return level;
+}
@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "include/server.h"
+#include "include/thread_pool.h"
+
+using namespace std;
+
+// Connections served at once; further ones wait in the listen backlog
+const size_t MAX_CLIENTS = 256;
+
+static void appendText(OutputBuffer& out, const string& text) {
+    out.append(text.data(), text.size());
+}
+
+// A response that carries no tokens, only message
+static void failure(OutputBuffer& out, const string& message) {
+    unsigned char header[5] = {LEX_FAILED};
+    out.clear();
+    out.append((const char*)header, sizeof(header));
+    appendText(out, message);
+}
+
+// Lex one request into a response payload
+static void answer(const Lexer& lexer, const string& request, OutputFormat format, OutputBuffer& out) {
+    if (request.empty() || (request[0] != LEX_PATH && request[0] != LEX_SOURCE)) {
+        failure(out, "Malformed request\n");
+        return;
+    }
+
+    SourceBuffer source;
+    if (request[0] == LEX_PATH) {
+        string path = request.substr(1);
+        if (!read_file(path.c_str(), source)) {
+            failure(out, "Failed to open file: " + path + ": " + strerror(errno) + "\n");
+            return;
+        }
+    } else {
+        source = SourceBuffer(request.data() + 1, request.size() - 1);
+    }
+    if (source.size() > MAX_SOURCE_SIZE) {
+        failure(out, "Source larger than 4 GiB\n");
+        return;
+    }
+
+    Diagnostics diagnostics;
+    failure(out, "");       // header only, patched once the tokens are written
+    size_t tokensAt = out.length();
+    unique_ptr<TokenWriter> writer = createTokenWriter(format, out);
+    writer->setSource(source.begin());
+    for (const TokenView& token : lexer.tokens(source, 0, &diagnostics)) {
+        writer->write(token);
+    }
+    writer->finish();
+
+    unsigned char header[5] = {diagnostics.empty() ? LEX_OK : LEX_ERRORS};
+    putUint32(header + 1, (uint32_t)(out.length() - tokensAt));
+    out.patch(0, header, sizeof(header));
+
+    diagnostics.locate(source.begin(), source.size());
+    for (const Diagnostic& diagnostic : diagnostics) {
+        appendText(out, diagnostic.message(source.begin()));
+        out.append('\n');
+    }
+    if (out.length() > MAX_FRAME_SIZE) {
+        failure(out, "Response larger than " + to_string(MAX_FRAME_SIZE >> 20) + " MiB\n");
+    }
+}
+
+// Answer requests on one connection until the client hangs up. Each request
+// is lexed with the newest rule set published when it arrives.
+static void serveConnection(const ReloadableLexer& rules, OutputFormat format, int in, int out) {
+    LexerSnapshot lexer(rules);
+    string request;
+    OutputBuffer response;
+    while (readFrame(in, request)) {
+        answer(lexer.get(), request, format, response);
+        if (!writeFrame(out, response.contents(), response.length())) {
+            break;
+        }
+    }
+}
+
+// Like serveConnection, but each request is lexed on the pool. The calling
+// thread only reads and writes frames, so a client that stays connected
+// holds a worker only while one of its requests is being lexed.
+static void serveClient(const ReloadableLexer& rules, OutputFormat format, WorkStealingPool& pool, int client) {
+    LexerSnapshot lexer(rules);
+    string request;
+    OutputBuffer response;
+    mutex lock;
+    condition_variable answered;
+    while (readFrame(client, request)) {
+        const Lexer& current = lexer.get();
+        bool done = false;
+        pool.submit([&] {
+            answer(current, request, format, response);
+            lock_guard<mutex> guard(lock);
+            done = true;
+            answered.notify_one();
+        });
+        {
+            unique_lock<mutex> guard(lock);
+            answered.wait(guard, [&] { return done; });
+        }
+        if (!writeFrame(client, response.contents(), response.length())) {
+            break;
+        }
+    }
+}
+
+static int serveSocket(const ReloadableLexer& rules, const ServerOptions& options) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (options.socketPath.size() >= sizeof(address.sun_path)) {
+        cerr << "Socket path too long: " << options.socketPath << endl;
+        return 1;
+    }
+    strcpy(address.sun_path, options.socketPath.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        perror("socket");
+        return 1;
+    }
+    unlink(options.socketPath.c_str());
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) < 0 || listen(listener, 64) < 0) {
+        perror("Error binding socket");
+        close(listener);
+        return 1;
+    }
+    cerr << "Serving on " << options.socketPath << " with " << options.threads << " worker(s)" << endl;
+
+    // Every connection gets a thread for its I/O, up to MAX_CLIENTS of them;
+    // requests are lexed on the pool, at most threads at once, so idle
+    // clients never starve the rest
+    WorkStealingPool pool(options.threads);
+    mutex clientsLock;
+    condition_variable clientClosed;
+    vector<int> clients;
+    bool stopping = false;
+
+    // SIGINT and SIGTERM are blocked in every thread (see runServer) and
+    // taken here: closing the listener ends the accept loop below
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    thread stopper([&] {
+        int received;
+        sigwait(&stopSignals, &received);
+        lock_guard<mutex> guard(clientsLock);
+        stopping = true;
+        shutdown(listener, SHUT_RDWR);
+        clientClosed.notify_all();
+    });
+
+    for (;;) {
+        {
+            unique_lock<mutex> guard(clientsLock);
+            clientClosed.wait(guard, [&] { return stopping || clients.size() < MAX_CLIENTS; });
+            if (stopping) break;
+        }
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            lock_guard<mutex> guard(clientsLock);
+            if (!stopping) perror("accept");
+            break;
+        }
+        {
+            lock_guard<mutex> guard(clientsLock);
+            clients.push_back(client);
+        }
+        thread([&, client] {
+            serveClient(rules, options.format, pool, client);
+            lock_guard<mutex> guard(clientsLock);
+            clients.erase(find(clients.begin(), clients.end(), client));
+            close(client);
+            clientClosed.notify_all();
+        }).detach();
+    }
+
+    // Wake every connection thread out of its read and wait for them to go
+    bool stopped;
+    {
+        unique_lock<mutex> guard(clientsLock);
+        stopped = stopping;
+        for (int client : clients) {
+            shutdown(client, SHUT_RDWR);
+        }
+        clientClosed.wait(guard, [&] { return clients.empty(); });
+    }
+    if (!stopped) {
+        pthread_kill(stopper.native_handle(), SIGTERM);
+    }
+    stopper.join();
+    pool.wait();
+    close(listener);
+    unlink(options.socketPath.c_str());
+    if (stopped) {
+        cerr << "Server stopped" << endl;
+    }
+    return stopped ? 0 : 1;
+}
+
+int runServer(ReloadableLexer& rules, const ServerOptions& options) {
+    // A client that hangs up mid-response must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+
+    // A socket server stops cleanly on SIGINT or SIGTERM. The signals are
+    // blocked before any thread starts, so only serveSocket's sigwait sees them.
+    if (!options.socketPath.empty()) {
+        sigset_t stopSignals;
+        sigemptyset(&stopSignals);
+        sigaddset(&stopSignals, SIGINT);
+        sigaddset(&stopSignals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+    }
+
+    RulesWatcher watcher(rules);
+    if (rules.getMode() != DIRECT_MODE) {
+        watcher.start();
+    }
+
+    if (options.socketPath.empty()) {
+        serveConnection(rules, options.format, STDIN_FILENO, options.output);
+        return 0;
+    }
+    return serveSocket(rules, options);
+}
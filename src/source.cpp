@@ -0,0 +1,187 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "include/source.h"
+
+using namespace std;
+
+SourceBuffer::SourceBuffer() : data(""), length(0), owned(nullptr), mapped(nullptr) {}
+
+SourceBuffer::SourceBuffer(const char* data, size_t length)
+    : data(data), length(length), owned(nullptr), mapped(nullptr) {}
+
+SourceBuffer::~SourceBuffer() {
+    release();
+}
+
+SourceBuffer::SourceBuffer(SourceBuffer&& other)
+    : data(other.data), length(other.length), owned(other.owned), mapped(other.mapped) {
+    other.data = "";
+    other.length = 0;
+    other.owned = nullptr;
+    other.mapped = nullptr;
+}
+
+SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) {
+    if (this != &other) {
+        release();
+        data = other.data;
+        length = other.length;
+        owned = other.owned;
+        mapped = other.mapped;
+        other.data = "";
+        other.length = 0;
+        other.owned = nullptr;
+        other.mapped = nullptr;
+    }
+    return *this;
+}
+
+void SourceBuffer::release() {
+    if (mapped != nullptr) {
+        munmap(mapped, length);
+    }
+    free(owned);
+    data = "";
+    length = 0;
+    owned = nullptr;
+    mapped = nullptr;
+}
+
+// Say why filename could not be loaded; errno is kept for the caller
+static bool loadFailed(const char* what, const char* filename, int error) {
+    fprintf(stderr, "%s %s: %s\n", what, filename, strerror(error));
+    errno = error;
+    return false;
+}
+
+bool SourceBuffer::loadFile(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return loadFailed("Error opening file", filename, errno);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int error = errno;
+        close(fd);
+        return loadFailed("Error opening file", filename, error);
+    }
+    if (S_ISDIR(st.st_mode)) {
+        close(fd);
+        return loadFailed("Error opening file", filename, EISDIR);
+    }
+    if (!S_ISREG(st.st_mode)) {
+        // Pipes and other special files are read like a stream
+        FILE* file = fdopen(fd, "r");
+        if (file == NULL) {
+            int error = errno;
+            close(fd);
+            return loadFailed("Error opening file", filename, error);
+        }
+        bool ok = loadStream(file);
+        int error = errno;
+        fclose(file);
+        if (!ok && error != EFBIG) {
+            return loadFailed("Error reading file", filename, error);
+        }
+        return ok;
+    }
+
+    release();
+    size_t size = (size_t)st.st_size;
+    if (size > MAX_SOURCE_SIZE) {
+        fprintf(stderr, "Error opening file: %s is larger than 4 GiB\n", filename);
+        close(fd);
+        errno = EFBIG;
+        return false;
+    }
+
+    if (size >= MMAP_THRESHOLD) {
+        void* region = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (region != MAP_FAILED) {
+            madvise(region, size, MADV_SEQUENTIAL);
+            close(fd);
+            mapped = region;
+            data = (const char*)region;
+            length = size;
+            return true;
+        }
+    }
+
+    char* buffer = (char*)malloc(size + 1);
+    if (buffer == NULL) {
+        close(fd);
+        return loadFailed("Error reading file", filename, ENOMEM);
+    }
+    // A file that shrank since fstat ends early; a failed read is an error,
+    // not a truncated source
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = read(fd, buffer + done, size - done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            int error = errno;
+            free(buffer);
+            close(fd);
+            return loadFailed("Error reading file", filename, error);
+        }
+        if (n == 0) break;
+        done += (size_t)n;
+    }
+    close(fd);
+
+    buffer[done] = '\0';
+    owned = buffer;
+    data = buffer;
+    length = done;
+    return true;
+}
+
+bool SourceBuffer::loadStream(FILE* file) {
+    release();
+
+    size_t capacity = 1 << 16;
+    size_t size = 0;
+    char* buffer = (char*)malloc(capacity + 1);
+    if (buffer == NULL) return false;
+
+    size_t n;
+    while ((n = fread(buffer + size, 1, capacity - size, file)) > 0) {
+        size += n;
+        if (size > MAX_SOURCE_SIZE) {
+            fprintf(stderr, "Error reading input: larger than 4 GiB\n");
+            free(buffer);
+            errno = EFBIG;
+            return false;
+        }
+        if (size == capacity) {
+            capacity *= 2;
+            char* grown = (char*)realloc(buffer, capacity + 1);
+            if (grown == NULL) {
+                free(buffer);
+                return false;
+            }
+            buffer = grown;
+        }
+    }
+
+    if (ferror(file)) {
+        int error = errno;
+        free(buffer);
+        errno = error;
+        return false;
+    }
+
+    buffer[size] = '\0';
+    owned = buffer;
+    data = buffer;
+    length = size;
+    return true;
+}
@@ -0,0 +1,117 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "include/symbol_table.h"
+
+using namespace std;
+
+// FNV-1a; the low bits pick the shard, the rest the slot
+static uint32_t symbolHash(string_view text) {
+    uint32_t h = 0x811c9dc5u;
+    for (char c : text) {
+        h = (h ^ (unsigned char)c) * 0x01000193u;
+    }
+    return h ^ (h >> 16);
+}
+
+// Copy text into the arena; long names get a block of their own
+const char* SymbolTable::Shard::store(string_view text) {
+    size_t length = text.size();
+    if (length > tailSize) {
+        if (length > ARENA_BLOCK_SIZE / 4) {
+            blocks.emplace_back(new char[length]);
+            memcpy(blocks.back().get(), text.data(), length);
+            return blocks.back().get();
+        }
+        blocks.emplace_back(new char[ARENA_BLOCK_SIZE]);
+        tail = blocks.back().get();
+        tailSize = ARENA_BLOCK_SIZE;
+    }
+    char* at = tail;
+    memcpy(at, text.data(), length);
+    tail += length;
+    tailSize -= length;
+    return at;
+}
+
+void SymbolTable::Shard::rehash(size_t size) {
+    vector<Slot> grown(size, Slot{0, 0});
+    size_t mask = size - 1;
+    for (const Slot& slot : slots) {
+        if (slot.entry == 0) continue;
+        size_t i = (slot.hash >> SHARD_BITS) & mask;
+        while (grown[i].entry != 0) i = (i + 1) & mask;
+        grown[i] = slot;
+    }
+    slots.swap(grown);
+}
+
+uint32_t SymbolTable::intern(string_view text) {
+    uint32_t hash = symbolHash(text);
+    uint32_t shardIndex = hash & (SHARD_COUNT - 1);
+    Shard& shard = shards[shardIndex];
+    lock_guard<mutex> guard(shard.lock);
+
+    if (shard.slots.empty()) shard.rehash(64);
+    size_t mask = shard.slots.size() - 1;
+    size_t i = (hash >> SHARD_BITS) & mask;
+    for (;;) {
+        const Slot& slot = shard.slots[i];
+        if (slot.entry == 0) break;
+        if (slot.hash == hash) {
+            string_view entry = shard.entries[slot.entry - 1];
+            if (entry.size() == text.size() && memcmp(entry.data(), text.data(), text.size()) == 0) {
+                return ((slot.entry - 1) << SHARD_BITS) | shardIndex;
+            }
+        }
+        i = (i + 1) & mask;
+    }
+
+    // New name: i is the empty slot the probe ended on. The id keeps the
+    // shard in its low bits, which leaves room for 2^26 names per shard.
+    if (shard.entries.size() >= MAX_SHARD_ENTRIES) {
+        throw length_error("symbol table full: too many distinct identifiers");
+    }
+    uint32_t local = (uint32_t)shard.entries.size();
+    shard.entries.push_back(string_view(shard.store(text), text.size()));
+    shard.slots[i] = Slot{hash, local + 1};
+    if (shard.entries.size() * 2 > shard.slots.size()) {
+        shard.rehash(shard.slots.size() * 2);
+    }
+    return (local << SHARD_BITS) | shardIndex;
+}
+
+string_view SymbolTable::name(uint32_t symbol) const {
+    const Shard& shard = shards[symbol & (SHARD_COUNT - 1)];
+    lock_guard<mutex> guard(shard.lock);
+    return shard.entries[symbol >> SHARD_BITS];
+}
+
+void SymbolTable::internAll(const SymbolTable& other) {
+    for (const Shard& shard : other.shards) {
+        lock_guard<mutex> guard(shard.lock);
+        for (string_view name : shard.entries) {
+            intern(name);
+        }
+    }
+}
+
+size_t SymbolTable::size() const {
+    size_t total = 0;
+    for (const Shard& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        total += shard.entries.size();
+    }
+    return total;
+}
+
+void SymbolTable::clear() {
+    for (Shard& shard : shards) {
+        lock_guard<mutex> guard(shard.lock);
+        shard.slots.clear();
+        shard.entries.clear();
+        shard.blocks.clear();
+        shard.tail = nullptr;
+        shard.tailSize = 0;
+    }
+}
@@ -0,0 +1,90 @@
+#include "include/thread_pool.h"
+
+using namespace std;
+
+WorkStealingPool::WorkStealingPool(size_t threads)
+    : queued(0), unfinished(0), nextQueue(0), stopping(false) {
+    if (threads == 0) threads = 1;
+    for (size_t i = 0; i < threads; i++) {
+        queues.push_back(unique_ptr<TaskQueue>(new TaskQueue()));
+    }
+    for (size_t i = 0; i < threads; i++) {
+        workers.push_back(thread(&WorkStealingPool::workerLoop, this, i));
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> guard(stateLock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(function<void()> task) {
+    size_t target = nextQueue.fetch_add(1) % queues.size();
+    unfinished++;
+    {
+        lock_guard<mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    {
+        lock_guard<mutex> guard(stateLock);
+        queued++;
+    }
+    workAvailable.notify_one();
+}
+
+bool WorkStealingPool::tryTake(size_t self, function<void()>& task) {
+    // Own work first, newest task
+    {
+        TaskQueue& own = *queues[self];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+    // Then steal the oldest task of another worker
+    for (size_t i = 1; i < queues.size(); i++) {
+        TaskQueue& victim = *queues[(self + i) % queues.size()];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(size_t self) {
+    for (;;) {
+        function<void()> task;
+        if (tryTake(self, task)) {
+            task();
+            if (--unfinished == 0) {
+                lock_guard<mutex> guard(stateLock);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        unique_lock<mutex> lock(stateLock);
+        workAvailable.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
+
+void WorkStealingPool::wait() {
+    unique_lock<mutex> lock(stateLock);
+    allDone.wait(lock, [this] { return unfinished == 0; });
+}
@@ -13,6 +13,26 @@ string Token::getValue() const {
 }
 
 string Token::getTypeName() const {
+    return typeToString(type);
+}
+
+string TokenView::toString() const {
+    string result = typeToString(type);
+    result += '(';
+    result.append(text.data(), text.size());
+    result += ')';
+    return result;
+}
+
+string TokenView::getValue() const {
+    return string(text);
+}
+
+string TokenView::getTypeName() const {
+    return typeToString(type);
+}
+
+const char* typeToString(Type type) {
     switch(type) {
         case KEYWORD: return "KEYWORD";
         case IDENTIFIER: return "IDENTIFIER";
@@ -32,6 +52,7 @@ string Token::getTypeName() const {
         case LBRACKET: return "LBRACKET";
         case RBRACKET: return "RBRACKET";
         case RANGE_OPERATOR: return "RANGE_OPERATOR";
+        case ERROR_TOKEN: return "ERROR_TOKEN";
         default: return "UNKNOWN";
     }
 }
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "include/token_cache.h"
+#include "include/scan.h"
+
+using namespace std;
+
+static const char CACHE_MAGIC[8] = {'P', 'S', 'T', 'O', 'K', 'C', 'H', '2'};
+
+struct CacheHeader {
+    char magic[8];
+    uint64_t contentHash;
+    uint64_t rulesHash;
+    uint64_t sourceSize;
+    uint64_t tokenCount;
+    uint64_t arenaBytes;
+};
+
+TokenCache::TokenCache(const string& directory, uint64_t maxBytes) : directory(directory), maxBytes(maxBytes) {}
+
+bool TokenCache::open() {
+    namespace fs = std::filesystem;
+    error_code ec;
+    fs::create_directories(directory, ec);
+    if (!fs::is_directory(directory, ec)) {
+        return false;
+    }
+
+    uint64_t total = 0;
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() == ".tok") {
+            total += it->file_size(ec);
+        }
+    }
+    // A smaller limit than the directory was filled under applies at once
+    lock_guard<mutex> guard(lock);
+    usedBytes = total;
+    if (usedBytes > maxBytes) {
+        evict();
+    }
+    return true;
+}
+
+string TokenCache::entryPath(uint64_t contentHash, uint64_t rulesHash) const {
+    char name[64];
+    snprintf(name, sizeof(name), "/%016" PRIx64 "-%016" PRIx64 ".tok", contentHash, rulesHash);
+    return directory + name;
+}
+
+bool TokenCache::load(const string& path, uint64_t contentHash, uint64_t rulesHash, const SourceBuffer& source,
+                      TokenStream& tokens, SymbolTable* symbols, pmr::memory_resource* memory) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(CacheHeader)) {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    // Private and writable: interning writes symbol ids into the mapped
+    // column, which copies only the pages touched
+    void* region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) return false;
+
+    CacheHeader header;
+    memcpy(&header, region, sizeof(header));
+    bool ok = memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+              header.contentHash == contentHash && header.rulesHash == rulesHash &&
+              header.sourceSize == source.size() && header.tokenCount <= size && header.arenaBytes <= size &&
+              sizeof(header) + TokenStream::imageSize(header.tokenCount, header.arenaBytes) == size;
+    if (!ok) {
+        munmap(region, size);
+    } else {
+        tokens = TokenStream(source.begin(), memory);
+        ok = tokens.adoptImage(region, size, sizeof(header), header.tokenCount, header.arenaBytes, source.size());
+    }
+
+    if (!ok) {
+        // Damaged or colliding entry: drop it so the next store replaces it
+        if (unlink(path.c_str()) == 0) {
+            lock_guard<mutex> guard(lock);
+            usedBytes -= min<uint64_t>(usedBytes, size);
+        }
+        tokens = TokenStream(source.begin(), memory);
+        return false;
+    }
+    if (symbols != nullptr) {
+        for (size_t i = 0; i < tokens.size(); i++) {
+            if (tokens.getType(i) == IDENTIFIER) {
+                tokens.setSymbol(i, symbols->intern(tokens.getText(i)));
+            }
+        }
+    }
+    utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+    return true;
+}
+
+void TokenCache::store(const string& path, uint64_t contentHash, uint64_t rulesHash, const SourceBuffer& source,
+                       const TokenStream& tokens) {
+    CacheHeader header;
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.contentHash = contentHash;
+    header.rulesHash = rulesHash;
+    header.sourceSize = source.size();
+    header.tokenCount = tokens.size();
+    header.arenaBytes = tokens.literalBytes();
+
+    string entry(sizeof(header) + tokens.imageSize(), '\0');
+    memcpy(&entry[0], &header, sizeof(header));
+    tokens.writeImage(&entry[sizeof(header)]);
+
+    // Write under a private name, then rename into place in one step
+    string temporary = path + ".tmp" + to_string(getpid()) + "-" + to_string(hash<thread::id>()(this_thread::get_id()));
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (file == nullptr) return;
+    bool written = fwrite(entry.data(), 1, entry.size(), file) == entry.size();
+    // An entry with the same name (written by another process) is replaced
+    struct stat old;
+    uint64_t replaced = stat(path.c_str(), &old) == 0 ? (uint64_t)old.st_size : 0;
+    if (fclose(file) != 0 || !written || rename(temporary.c_str(), path.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return;
+    }
+    stores++;
+
+    lock_guard<mutex> guard(lock);
+    usedBytes += entry.size();
+    usedBytes -= min(usedBytes, replaced);
+    if (usedBytes > maxBytes) {
+        evict();
+    }
+}
+
+// Remove least recently used entries until the directory is at 3/4 of its
+// limit, so a full cache is not rescanned on every store. Caller holds lock.
+void TokenCache::evict() {
+    namespace fs = std::filesystem;
+    struct Entry {
+        fs::path path;
+        fs::file_time_type used;
+        uint64_t size;
+    };
+    vector<Entry> entries;
+    uint64_t total = 0;
+    error_code ec;
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() != ".tok") continue;
+        error_code entryError;
+        Entry entry{it->path(), it->last_write_time(entryError), it->file_size(entryError)};
+        if (entryError) continue;
+        total += entry.size;
+        entries.push_back(entry);
+    }
+    sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.used < b.used; });
+
+    uint64_t target = maxBytes / 4 * 3;
+    for (const Entry& entry : entries) {
+        if (total <= target) break;
+        if (fs::remove(entry.path, ec)) {
+            total -= entry.size;
+            evictions++;
+        }
+    }
+    usedBytes = total;
+}
+
+TokenStream TokenCache::lex(const Lexer& lexer, const SourceBuffer& source, Diagnostics* diagnostics,
+                            SymbolTable* symbols, pmr::memory_resource* memory) {
+    uint64_t contentHash = hashBytes(source.begin(), source.size());
+    uint64_t rulesHash = lexer.fingerprint();
+    string path = entryPath(contentHash, rulesHash);
+
+    TokenStream tokens(source.begin(), memory);
+    if (load(path, contentHash, rulesHash, source, tokens, symbols, memory)) {
+        hits++;
+        return tokens;
+    }
+    misses++;
+
+    size_t errorsBefore = diagnostics != nullptr ? diagnostics->size() : 0;
+    tokens = lexer.lex(source, diagnostics, symbols, memory);
+    if (diagnostics == nullptr || diagnostics->size() == errorsBefore) {
+        store(path, contentHash, rulesHash, source, tokens);
+    }
+    return tokens;
+}
+
+void TokenCache::printStats(ostream& out) const {
+    size_t lookups = hits + misses;
+    out << "Token cache: " << hits << " hit(s), " << misses << " miss(es)";
+    if (lookups > 0) {
+        out << " (" << hits * 100 / lookups << "% hits)";
+    }
+    out << ", " << stores << " stored, " << evictions << " evicted" << endl;
+}
@@ -0,0 +1,247 @@
+#include <cstring>
+#include <sys/mman.h>
+#include <utility>
+
+#include "include/token_stream.h"
+
+using namespace std;
+
+static bool isLiteralType(Type type) {
+    return type == CHAR_LITERAL || type == STRING_LITERAL;
+}
+
+static const size_t BYTES_PER_TOKEN = 4 * sizeof(uint32_t) + sizeof(uint8_t);
+
+TokenStream::TokenStream(pmr::memory_resource* memory)
+    : source(""), memory(memory), block(nullptr), offsets(nullptr), lengths(nullptr), literals(nullptr),
+      symbols(nullptr), types(nullptr), count(0), capacity(0), arena(nullptr), arenaSize(0), arenaCapacity(0),
+      mapping(nullptr), mappingSize(0) {}
+
+TokenStream::TokenStream(const char* source, pmr::memory_resource* memory) : TokenStream(memory) {
+    this->source = source;
+}
+
+TokenStream::~TokenStream() {
+    releaseStorage();
+}
+
+void TokenStream::releaseStorage() {
+    if (block != nullptr) memory->deallocate(block, capacity * BYTES_PER_TOKEN, alignof(uint32_t));
+    if (arenaCapacity > 0) memory->deallocate(arena, arenaCapacity, alignof(uint32_t));
+    if (mapping != nullptr) munmap(mapping, mappingSize);
+}
+
+TokenStream::TokenStream(TokenStream&& other) : TokenStream() {
+    *this = std::move(other);
+}
+
+TokenStream& TokenStream::operator=(TokenStream&& other) {
+    if (this != &other) {
+        releaseStorage();
+        source = other.source;
+        ownedSource = std::move(other.ownedSource);
+        memory = other.memory;
+        block = other.block;
+        offsets = other.offsets;
+        lengths = other.lengths;
+        literals = other.literals;
+        symbols = other.symbols;
+        types = other.types;
+        count = other.count;
+        capacity = other.capacity;
+        arena = other.arena;
+        arenaSize = other.arenaSize;
+        arenaCapacity = other.arenaCapacity;
+        mapping = other.mapping;
+        mappingSize = other.mappingSize;
+
+        other.source = "";
+        other.block = nullptr;
+        other.offsets = other.lengths = other.literals = other.symbols = nullptr;
+        other.types = nullptr;
+        other.count = other.capacity = 0;
+        other.arena = nullptr;
+        other.arenaSize = other.arenaCapacity = 0;
+        other.mapping = nullptr;
+        other.mappingSize = 0;
+    }
+    return *this;
+}
+
+void TokenStream::adoptSource(SourceBuffer&& buffer) {
+    ownedSource = std::move(buffer);
+    source = ownedSource.begin();
+}
+
+void TokenStream::reserve(size_t tokens) {
+    if (tokens <= capacity) return;
+
+    // Arrays share one block: four uint32_t columns followed by the type bytes
+    void* grown = memory->allocate(tokens * BYTES_PER_TOKEN, alignof(uint32_t));
+
+    uint32_t* newOffsets = (uint32_t*)grown;
+    uint32_t* newLengths = newOffsets + tokens;
+    uint32_t* newLiterals = newLengths + tokens;
+    uint32_t* newSymbols = newLiterals + tokens;
+    uint8_t* newTypes = (uint8_t*)(newSymbols + tokens);
+    if (count > 0) {
+        memcpy(newOffsets, offsets, count * sizeof(uint32_t));
+        memcpy(newLengths, lengths, count * sizeof(uint32_t));
+        memcpy(newLiterals, literals, count * sizeof(uint32_t));
+        memcpy(newSymbols, symbols, count * sizeof(uint32_t));
+        memcpy(newTypes, types, count);
+    }
+
+    if (block != nullptr) memory->deallocate(block, capacity * BYTES_PER_TOKEN, alignof(uint32_t));
+    block = grown;
+    offsets = newOffsets;
+    lengths = newLengths;
+    literals = newLiterals;
+    symbols = newSymbols;
+    types = newTypes;
+    capacity = tokens;
+}
+
+void TokenStream::grow() {
+    reserve(capacity < 1024 ? 1024 : capacity * 2);
+}
+
+void TokenStream::clear() {
+    if (mapping != nullptr) {
+        // An adopted image is read-only as far as push() is concerned
+        releaseStorage();
+        block = arena = nullptr;
+        offsets = lengths = literals = symbols = nullptr;
+        types = nullptr;
+        capacity = arenaCapacity = 0;
+        mapping = nullptr;
+        mappingSize = 0;
+    }
+    count = 0;
+    arenaSize = 0;
+}
+
+static size_t columnsSize(size_t tokens) {
+    return (tokens * BYTES_PER_TOKEN + 3) & ~(size_t)3;
+}
+
+size_t TokenStream::imageSize(size_t tokens, size_t arenaBytes) {
+    return columnsSize(tokens) + arenaBytes;
+}
+
+// Symbol ids only mean something to the SymbolTable that gave them out,
+// so the image has NO_SYMBOL for every token
+void TokenStream::writeImage(char* out) const {
+    size_t column = count * sizeof(uint32_t);
+    if (count > 0) {
+        memcpy(out, offsets, column);
+        memcpy(out + column, lengths, column);
+        memcpy(out + 2 * column, literals, column);
+        memset(out + 3 * column, 0xFF, column);
+        memcpy(out + 4 * column, types, count);
+    }
+    memset(out + count * BYTES_PER_TOKEN, 0, columnsSize(count) - count * BYTES_PER_TOKEN);
+    if (arenaSize > 0) memcpy(out + columnsSize(count), arena, arenaSize);
+}
+
+bool TokenStream::adoptImage(void* region, size_t regionSize, size_t imageAt, size_t tokens, size_t arenaBytes,
+                             size_t sourceSize) {
+    clear();
+    releaseStorage();
+    char* image = (char*)region + imageAt;
+    block = nullptr;
+    offsets = (uint32_t*)image;
+    lengths = offsets + tokens;
+    literals = lengths + tokens;
+    symbols = literals + tokens;
+    types = (uint8_t*)(symbols + tokens);
+    count = capacity = tokens;
+    arena = image + columnsSize(tokens);
+    arenaSize = arenaBytes;
+    arenaCapacity = 0;
+    mapping = region;
+    mappingSize = regionSize;
+
+    for (size_t i = 0; i < count; i++) {
+        if (types[i] > ERROR_TOKEN || offsets[i] > sourceSize || lengths[i] > sourceSize - offsets[i] ||
+            symbols[i] != NO_SYMBOL) {
+            return false;
+        }
+        uint32_t literal = literals[i];
+        if (literal != NO_LITERAL) {
+            uint32_t length;
+            if (literal > arenaSize || arenaSize - literal < sizeof(length)) return false;
+            memcpy(&length, arena + literal, sizeof(length));
+            if (length > arenaSize - literal - sizeof(length)) return false;
+        }
+    }
+    return true;
+}
+
+uint32_t TokenStream::storeLiteral(string_view text) {
+    size_t needed = arenaSize + sizeof(uint32_t) + text.size();
+    if (needed > arenaCapacity) {
+        size_t newCapacity = arenaCapacity < 4096 ? 4096 : arenaCapacity * 2;
+        while (newCapacity < needed) newCapacity *= 2;
+        char* grown = (char*)memory->allocate(newCapacity, alignof(uint32_t));
+        if (arena != nullptr) {
+            memcpy(grown, arena, arenaSize);
+            if (arenaCapacity > 0) memory->deallocate(arena, arenaCapacity, alignof(uint32_t));
+        }
+        arena = grown;
+        arenaCapacity = newCapacity;
+    }
+
+    uint32_t at = (uint32_t)arenaSize;
+    uint32_t length = (uint32_t)text.size();
+    memcpy(arena + arenaSize, &length, sizeof(length));
+    memcpy(arena + arenaSize + sizeof(length), text.data(), text.size());
+    arenaSize = needed;
+    return at;
+}
+
+// Text a token has when nothing was stored for it: the lexeme, minus quotes for literals
+string_view TokenStream::lexemeText(size_t index) const {
+    const char* start = source + offsets[index];
+    uint32_t length = lengths[index];
+    if (isLiteralType((Type)types[index]) && length >= 2) {
+        return string_view(start + 1, length - 2);
+    }
+    return string_view(start, length);
+}
+
+void TokenStream::push(const TokenView& token) {
+    if (count == capacity) grow();
+
+    offsets[count] = token.offset;
+    lengths[count] = token.length;
+    types[count] = (uint8_t)token.type;
+    literals[count] = NO_LITERAL;
+    symbols[count] = token.symbol;
+
+    string_view plain = lexemeText(count);
+    if (token.text.data() != plain.data() || token.text.size() != plain.size()) {
+        literals[count] = storeLiteral(token.text);
+    }
+    count++;
+}
+
+string_view TokenStream::getText(size_t index) const {
+    uint32_t literal = literals[index];
+    if (literal == NO_LITERAL) {
+        return lexemeText(index);
+    }
+    uint32_t length;
+    memcpy(&length, arena + literal, sizeof(length));
+    return string_view(arena + literal + sizeof(length), length);
+}
+
+TokenView TokenStream::operator[](size_t index) const {
+    TokenView token;
+    token.type = (Type)types[index];
+    token.text = getText(index);
+    token.offset = offsets[index];
+    token.length = lengths[index];
+    token.symbol = symbols[index];
+    return token;
+}
@@ -0,0 +1,10 @@
+program errors;
+{ Every kind of lexical error, for comparing lexer modes under -r }
+var a, s : integer;
+begin
+  a := 1 @# 2;
+  s := 'abc
+  } a := 3;
+  s := 'café' + '';
+  a := a ? 4 ;
+  (* comment 
@@ -0,0 +1,136 @@
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "check.h"
+#include "../../src/include/lexer.h"
+#include "../../src/include/symbol_table.h"
+#include "../../src/include/token_cache.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+typedef tuple<int, uint32_t, uint32_t, string, uint32_t> TokenFields;
+
+static const char* SAMPLE =
+    "program p; { comment } var s: string;\n"
+    "begin s := 'x\\'y' + 'tab\\t' + 'plain'; (* more *) s := 'q\\\\' + 'tab\\t'; n := 12 end.\n";
+
+// Fresh directory under /tmp, removed when the test is done
+struct TemporaryDirectory {
+    string path;
+    TemporaryDirectory() {
+        char name[] = "/tmp/unit_cache_XXXXXX";
+        path = mkdtemp(name) ? name : "";
+    }
+    ~TemporaryDirectory() {
+        error_code ec;
+        fs::remove_all(path, ec);
+    }
+};
+
+static vector<TokenFields> fields(const TokenStream& tokens) {
+    vector<TokenFields> all;
+    for (const TokenView& token : tokens) {
+        all.emplace_back(token.type, token.offset, token.length, string(token.text), token.symbol);
+    }
+    return all;
+}
+
+static string onlyEntry(const string& directory) {
+    for (const fs::directory_entry& entry : fs::directory_iterator(directory)) {
+        if (entry.path().extension() == ".tok") return entry.path();
+    }
+    return "";
+}
+
+static uint64_t directoryBytes(const string& directory) {
+    uint64_t total = 0;
+    for (const fs::directory_entry& entry : fs::directory_iterator(directory)) {
+        total += entry.file_size();
+    }
+    return total;
+}
+
+// A hit returns what lexing returns, escaped literals and symbol ids included
+TEST(cacheHitMatchesLex) {
+    TemporaryDirectory directory;
+    Lexer lexer(DFA_MODE);
+    string text = SAMPLE;
+    SourceBuffer source(text.data(), text.size());
+
+    SymbolTable expectedSymbols;
+    vector<TokenFields> expected = fields(lexer.lex(source, nullptr, &expectedSymbols));
+
+    TokenCache cache(directory.path);
+    CHECK(cache.open());
+    SymbolTable missSymbols;
+    CHECK(fields(cache.lex(lexer, source, nullptr, &missSymbols)) == expected);
+    SymbolTable hitSymbols;
+    TokenStream hit = cache.lex(lexer, source, nullptr, &hitSymbols);
+    CHECK(fields(hit) == expected);
+    CHECK_EQ(cache.getHits(), (size_t)1);
+    CHECK_EQ(cache.getMisses(), (size_t)1);
+
+    // A stream served from the mapping still grows and clears like any other
+    TokenView extra = hit[0];
+    hit.push(extra);
+    CHECK_EQ(hit.size(), expected.size() + 1);
+    CHECK(fields(hit).back() == expected.front());
+    hit.clear();
+    hit.push(extra);
+    CHECK_EQ(hit.size(), (size_t)1);
+}
+
+// A damaged entry is a miss, and the next store replaces it
+TEST(cacheReplacesDamagedEntry) {
+    TemporaryDirectory directory;
+    Lexer lexer(DFA_MODE);
+    string text = SAMPLE;
+    SourceBuffer source(text.data(), text.size());
+    vector<TokenFields> expected = fields(lexer.lex(source));
+
+    TokenCache cache(directory.path);
+    CHECK(cache.open());
+    cache.lex(lexer, source);
+    string entry = onlyEntry(directory.path);
+    CHECK(!entry.empty());
+
+    // Point the first token past the end of the source
+    FILE* file = fopen(entry.c_str(), "r+b");
+    CHECK(file != nullptr);
+    if (file != nullptr) {
+        uint32_t offset = 0x7FFFFFFF;
+        fseek(file, 48, SEEK_SET);
+        fwrite(&offset, sizeof(offset), 1, file);
+        fclose(file);
+    }
+    CHECK(fields(cache.lex(lexer, source)) == expected);
+    CHECK_EQ(cache.getMisses(), (size_t)2);
+    CHECK(fields(cache.lex(lexer, source)) == expected);
+    CHECK_EQ(cache.getHits(), (size_t)1);
+}
+
+// Opening a directory with a smaller limit evicts down to it
+TEST(cacheOpenEvictsOverLimit) {
+    TemporaryDirectory directory;
+    Lexer lexer(DFA_MODE);
+    vector<string> texts;
+    for (int i = 0; i < 8; i++) {
+        texts.push_back(string(SAMPLE) + "x" + to_string(i) + " := " + to_string(i) + ";\n");
+    }
+    {
+        TokenCache cache(directory.path);
+        CHECK(cache.open());
+        for (const string& text : texts) {
+            cache.lex(lexer, SourceBuffer(text.data(), text.size()));
+        }
+    }
+    uint64_t full = directoryBytes(directory.path);
+    TokenCache smaller(directory.path, full / 2);
+    CHECK(smaller.open());
+    CHECK(directoryBytes(directory.path) <= full / 2);
+}
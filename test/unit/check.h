@@ -0,0 +1,52 @@
+#ifndef UNIT_CHECK_H
+#define UNIT_CHECK_H
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Minimal test registry for bin/unit_tests. A test is a function declared
+// with TEST(name); CHECK and CHECK_EQ record failures and let it go on.
+
+struct UnitTest {
+    const char* name;
+    void (*run)();
+};
+
+vector<UnitTest>& unitTests();
+extern int checkFailures;
+
+struct RegisterTest {
+    RegisterTest(const char* name, void (*run)()) { unitTests().push_back(UnitTest{name, run}); }
+};
+
+#define TEST(name)                                                \
+    static void name();                                           \
+    static RegisterTest name##_registration(#name, name);         \
+    static void name()
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            checkFailures++;                                                          \
+        }                                                                             \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                    \
+    do {                                                                              \
+        auto actualValue = (actual);                                                  \
+        auto expectedValue = (expected);                                              \
+        if (!(actualValue == expectedValue)) {                                        \
+            ostringstream message;                                                    \
+            message << actualValue << " != " << expectedValue;                        \
+            fprintf(stderr, "%s:%d: CHECK_EQ failed: %s == %s (%s)\n", __FILE__, __LINE__, \
+                    #actual, #expected, message.str().c_str());                       \
+            checkFailures++;                                                          \
+        }                                                                             \
+    } while (0)
+
+#endif // UNIT_CHECK_H
@@ -0,0 +1,35 @@
+#include <stdexcept>
+#include <string>
+
+#include "check.h"
+#include "../../src/include/diagnostics.h"
+
+using namespace std;
+
+// Control and non-ASCII bytes are shown escaped, never raw
+TEST(diagnosticMessageEscapesBytes) {
+    string text = "a\x01\xff@";
+    Diagnostics diagnostics;
+    for (size_t offset = 1; offset < text.size(); offset++) {
+        diagnostics.add(UNRECOGNIZED_CHARACTER, offset, 1);
+    }
+    diagnostics.locate(text.data(), text.size());
+    CHECK_EQ(diagnostics[0].message(text.data()),
+             string("ERROR: Unrecognized character '\\x01' at line 1, column 2 (position 1)"));
+    CHECK_EQ(diagnostics[1].message(text.data()),
+             string("ERROR: Unrecognized character '\\xff' at line 1, column 3 (position 2)"));
+    CHECK_EQ(diagnostics[2].message(text.data()),
+             string("ERROR: Unrecognized character '@' at line 1, column 4 (position 3)"));
+}
+
+TEST(diagnosticsRejectPositionsPast4GiB) {
+    Diagnostics diagnostics;
+    bool thrown = false;
+    try {
+        diagnostics.add(UNTERMINATED_COMMENT, 0xFFFFFFF0ull, 0x20);
+    } catch (const length_error&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(diagnostics.empty());
+}
@@ -0,0 +1,140 @@
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "check.h"
+#include "../../src/include/diagnostics.h"
+#include "../../src/include/incremental.h"
+#include "../../src/include/lexer.h"
+
+using namespace std;
+
+// (type, offset, length, text) of a token; (kind, offset, length) of an error
+typedef tuple<int, uint32_t, uint32_t, string> TokenFields;
+typedef tuple<int, uint32_t, uint32_t> ErrorFields;
+
+static const LexerMode MODES[] = {DFA_MODE, DIRECT_MODE};
+
+static string readText(const char* path) {
+    ifstream in(path, ios::binary);
+    stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+static vector<ErrorFields> errorFields(const Diagnostics& diagnostics) {
+    vector<ErrorFields> errors;
+    for (const Diagnostic& error : diagnostics) {
+        errors.emplace_back(error.kind, error.offset, error.length);
+    }
+    return errors;
+}
+
+// Tokens and errors of a fresh recover-mode lex of text
+static void fullLex(const Lexer& lexer, const string& text,
+                    vector<TokenFields>& tokens, vector<ErrorFields>& errors) {
+    SourceBuffer source(text.data(), text.size());
+    Diagnostics diagnostics;
+    for (const TokenView& token : lexer.tokens(source, 0, &diagnostics)) {
+        tokens.emplace_back(token.type, token.offset, token.length, string(token.text));
+    }
+    errors = errorFields(diagnostics);
+}
+
+// True when the incremental lexer holds exactly what a full lex of text gives
+static bool matchesFullLex(const Lexer& lexer, const IncrementalLexer& incremental, const string& text) {
+    vector<TokenFields> expected;
+    vector<ErrorFields> expectedErrors;
+    fullLex(lexer, text, expected, expectedErrors);
+
+    vector<TokenFields> actual;
+    for (const TokenView& token : incremental) {
+        actual.emplace_back(token.type, token.offset, token.length, string(token.text));
+    }
+    return actual == expected && incremental.size() == expected.size() &&
+           errorFields(incremental.diagnostics()) == expectedErrors;
+}
+
+// Errors at the end of the text, including ones an edit opens or closes
+TEST(incrementalUnterminatedAtEnd) {
+    for (LexerMode mode : MODES) {
+        Lexer lexer(mode);
+        IncrementalLexer incremental(lexer);
+        string text = "x := 'abc";
+        incremental.reset(text);
+        CHECK(matchesFullLex(lexer, incremental, text));
+        CHECK(!incremental.diagnostics().empty());
+
+        // Close the literal, then open a comment in front of later tokens
+        text += "'; y := 1";
+        incremental.applyEdit(text, TextEdit{9, 0, 9});
+        CHECK(matchesFullLex(lexer, incremental, text));
+        CHECK(incremental.diagnostics().empty());
+
+        text.insert(0, "{ ");
+        incremental.applyEdit(text, TextEdit{0, 0, 2});
+        CHECK(matchesFullLex(lexer, incremental, text));
+        CHECK(!incremental.diagnostics().empty());
+
+        text.erase(0, 2);
+        incremental.applyEdit(text, TextEdit{0, 2, 0});
+        CHECK(matchesFullLex(lexer, incremental, text));
+    }
+}
+
+// A fresh text after reset re-lexes as little as before the first one
+TEST(incrementalResetClearsLookahead) {
+    Lexer lexer(DFA_MODE);
+    IncrementalLexer incremental(lexer);
+    string text = "{" + string(4000, 'a');
+    incremental.reset(text);
+    CHECK(matchesFullLex(lexer, incremental, text));
+
+    string plain;
+    for (int i = 0; i < 2000; i++) plain += "x ";
+    incremental.reset(plain);
+    plain[2000] = 'y';
+    incremental.applyEdit(plain, TextEdit{2000, 1, 1});
+    CHECK(matchesFullLex(lexer, incremental, plain));
+    CHECK(incremental.lastRelexed() < 8);
+}
+
+// Random edits, including ones that break and repair lexemes, always leave
+// the token list and errors of a full lex
+TEST(incrementalRandomEditsMatchFullLex) {
+    static const char* const PIECES[] = {
+        "'", "{", "}", "(*", "*)", "@", "\n", " ", "x", "begin", "9", "1.5", "\\", ":=",
+        "..", "\xc3\xa9", "\xff", "end.", "'ab'",
+    };
+    const size_t pieceCount = sizeof(PIECES) / sizeof(PIECES[0]);
+    string seed = readText("test/milestone-1/big_guy.pas");
+    CHECK(!seed.empty());
+
+    for (LexerMode mode : MODES) {
+        Lexer lexer(mode);
+        IncrementalLexer incremental(lexer);
+        string text = seed + seed;
+        incremental.reset(text);
+        CHECK(matchesFullLex(lexer, incremental, text));
+
+        mt19937 random(7);
+        int mismatches = 0;
+        for (int i = 0; i < 1500 && mismatches < 5; i++) {
+            size_t offset = random() % (text.size() + 1);
+            size_t removed = min<size_t>(random() % 4, text.size() - offset);
+            string inserted;
+            for (size_t n = random() % 3; n > 0; n--) inserted += PIECES[random() % pieceCount];
+            text.replace(offset, removed, inserted);
+            incremental.applyEdit(text, TextEdit{offset, removed, inserted.size()});
+            if (!matchesFullLex(lexer, incremental, text)) {
+                fprintf(stderr, "mismatch after edit %d (offset %zu, removed %zu, inserted %zu)\n",
+                        i, offset, removed, inserted.size());
+                mismatches++;
+            }
+        }
+        CHECK_EQ(mismatches, 0);
+    }
+}
@@ -0,0 +1,30 @@
+#include <cstring>
+
+#include "check.h"
+
+using namespace std;
+
+int checkFailures = 0;
+
+vector<UnitTest>& unitTests() {
+    static vector<UnitTest> tests;
+    return tests;
+}
+
+// Run every test, or those whose name contains argv[1]
+int main(int argc, char* argv[]) {
+    const char* filter = argc > 1 ? argv[1] : "";
+    int failed = 0;
+    int run = 0;
+    for (const UnitTest& test : unitTests()) {
+        if (strstr(test.name, filter) == nullptr) continue;
+        int before = checkFailures;
+        test.run();
+        run++;
+        bool passed = checkFailures == before;
+        printf("%s %s\n", passed ? "PASS" : "FAIL", test.name);
+        if (!passed) failed++;
+    }
+    printf("%d test(s), %d failed\n", run, failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "check.h"
+#include "../../src/include/diagnostics.h"
+#include "../../src/include/lexer.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+typedef tuple<int, uint32_t, uint32_t, string> TokenFields;
+
+static vector<TokenFields> fields(const TokenStream& tokens) {
+    vector<TokenFields> all;
+    for (const TokenView& token : tokens) {
+        all.emplace_back(token.type, token.offset, token.length, string(token.text));
+    }
+    return all;
+}
+
+static string readText(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) return "";
+    string text;
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) text.append(chunk, n);
+    fclose(file);
+    return text;
+}
+
+// Rules written by --compile-rules lex exactly like the text they came from
+TEST(compiledRulesRoundTrip) {
+    char name[] = "/tmp/unit_rules_XXXXXX";
+    CHECK(mkdtemp(name) != nullptr);
+    string rules = string(name) + "/rules.dfa";
+    fs::copy_file("rules/pascal_lexicon.dfa", rules);
+    Lexer fromText(DFA_MODE, rules);
+    CHECK(fromText.compileRules(rules + ".bin", rules));
+    Lexer fromBinary(DFA_MODE, rules + ".bin");
+    CHECK_EQ(fromBinary.getMode(), DFA_MODE);
+    CHECK_EQ(fromBinary.fingerprint(), fromText.fingerprint());
+
+    vector<string> texts = {
+        readText("test/milestone-1/big_guy.pas"),
+        readText("test/errors/lexical_errors.pas"),
+        "x := 'caf\xc3\xa9' { \xff } @ 1.5e3 (* open",
+    };
+    for (const string& text : texts) {
+        SourceBuffer source(text.data(), text.size());
+        Diagnostics textErrors, binaryErrors;
+        CHECK(fields(fromBinary.lex(source, &binaryErrors)) == fields(fromText.lex(source, &textErrors)));
+        CHECK(!text.empty());
+        CHECK_EQ(binaryErrors.size(), textErrors.size());
+    }
+    error_code ec;
+    fs::remove_all(name, ec);
+}
@@ -0,0 +1,73 @@
+#include <string>
+#include <vector>
+
+#include "check.h"
+#include "../../src/include/diagnostics.h"
+#include "../../src/include/lexer.h"
+
+using namespace std;
+
+static const LexerMode MODES[] = {DFA_MODE, SWITCH_MODE, DIRECT_MODE};
+
+// Every token of text as (type, text) pairs, through the plain iterator
+static vector<pair<Type, string>> plainTokens(const Lexer& lexer, const SourceBuffer& source) {
+    vector<pair<Type, string>> tokens;
+    Diagnostics diagnostics;
+    for (const TokenView& token : lexer.tokens(source, 0, &diagnostics)) {
+        tokens.emplace_back(token.type, string(token.text));
+    }
+    return tokens;
+}
+
+// A token returned by next() keeps its text when peek() lexes further
+TEST(tokenCursorPeekKeepsEscapedText) {
+    string text = "'a\\n' 'b\\t' x";
+    SourceBuffer source(text.c_str(), text.size());
+    for (LexerMode mode : MODES) {
+        Lexer lexer(mode);
+        TokenCursor cursor = lexer.tokens(source);
+        TokenView first;
+        CHECK(cursor.next(first));
+        const TokenView* second = cursor.peek(0);
+        CHECK(second != nullptr);
+        CHECK_EQ(string(first.text), string("a\n"));
+        if (second != nullptr) {
+            CHECK_EQ(string(second->text), string("b\t"));
+        }
+        const TokenView* third = cursor.peek(1);
+        CHECK(third != nullptr && third->text == "x");
+        CHECK_EQ(string(first.text), string("a\n"));
+    }
+}
+
+// Any mix of next() and peek(k) yields the same tokens as plain iteration
+TEST(tokenCursorInterleavedPeekMatchesIteration) {
+    string text =
+        "program p; { comment } var s: string;\n"
+        "begin s := 'x\\'y' + 'tab\\t' + 'plain'; (* more *) s := 'q\\\\' end.\n";
+    SourceBuffer source(text.c_str(), text.size());
+    for (LexerMode mode : MODES) {
+        Lexer lexer(mode);
+        vector<pair<Type, string>> expected = plainTokens(lexer, source);
+        for (size_t depth = 0; depth < 4; depth++) {
+            Diagnostics diagnostics;
+            TokenCursor cursor = lexer.tokens(source, 0, &diagnostics);
+            vector<pair<Type, string>> seen;
+            TokenView token;
+            for (size_t i = 0; cursor.next(token); i++) {
+                pair<Type, string> returned(token.type, string(token.text));
+                // Peek a varying distance ahead, then check the returned token again
+                for (size_t k = 0; k < (i + depth) % 4; k++) {
+                    const TokenView* ahead = cursor.peek(k);
+                    if (ahead == nullptr) break;
+                    if (i + 1 + k < expected.size()) {
+                        CHECK_EQ(string(ahead->text), expected[i + 1 + k].second);
+                    }
+                }
+                CHECK_EQ(string(token.text), returned.second);
+                seen.push_back(returned);
+            }
+            CHECK(seen == expected);
+        }
+    }
+}
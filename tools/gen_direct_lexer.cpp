@@ -0,0 +1,168 @@
+// Writes a direct-coded C++ matcher for a rules file, in the style of re2c:
+// one labelled block per DFA state, a switch on the next byte and a goto
+// to the target state.
+//
+//   gen_direct_lexer rules/pascal_lexicon.dfa src/generated/direct_lexer.cpp
+//
+// The rules are parsed and minimised by the same DFA class the interpreted
+// lexer uses, so both modes see exactly the same automaton.
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../src/include/dfa.h"
+#include "../src/include/lexicon.h"
+
+using namespace std;
+
+static string byteLabel(int c) {
+    char buffer[16];
+    if (c >= 0x20 && c < 0x7f && c != '\'' && c != '\\') {
+        snprintf(buffer, sizeof(buffer), "'%c'", c);
+    } else {
+        snprintf(buffer, sizeof(buffer), "0x%02x", c);
+    }
+    return buffer;
+}
+
+static string charLiteral(char c) {
+    char buffer[16];
+    if (c >= 0x20 && c < 0x7f && c != '\'' && c != '\\') {
+        snprintf(buffer, sizeof(buffer), "'%c'", c);
+    } else {
+        snprintf(buffer, sizeof(buffer), "'\\x%02x'", (unsigned char)c);
+    }
+    return buffer;
+}
+
+static string tagName(int tag) {
+    if (tag == STATE_COMMENT) return "STATE_COMMENT";
+    return typeToString((Type)tag);
+}
+
+// Transitions of one state: a case list per target, dead transitions
+// falling through to default
+static void writeSwitch(FILE* out, const DFA& dfa, uint16_t state) {
+    map<uint16_t, vector<int>> targets;
+    for (int c = 0; c < 256; c++) {
+        uint16_t target = dfa.next(state, (unsigned char)c);
+        if (target != DFA::ERROR_STATE) targets[target].push_back(c);
+    }
+
+    fprintf(out, "    if (p >= end) goto done;\n");
+    fprintf(out, "    switch ((unsigned char)*p) {\n");
+    for (const auto& entry : targets) {
+        const vector<int>& bytes = entry.second;
+        for (size_t i = 0; i < bytes.size(); i++) {
+            fprintf(out, "%s%s", i % 8 == 0 ? (i == 0 ? "        " : "\n        ") : " ",
+                    ("case " + byteLabel(bytes[i]) + ":").c_str());
+        }
+        fprintf(out, "\n            p++;\n            goto S%u;\n", entry.first);
+    }
+    fprintf(out, "        default:\n            goto done;\n    }\n\n");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <rules.dfa> <output.cpp>\n", argv[0]);
+        return 1;
+    }
+    const char* rulesFile = argv[1];
+
+    DFA dfa;
+    dfa.setStateTagNames(lexiconStateTags());
+    if (!dfa.loadDFAFromFile(rulesFile)) {
+        fprintf(stderr, "%s: cannot load rules from %s\n", argv[0], rulesFile);
+        return 1;
+    }
+
+    // Only states something jumps to get a label, or the compiler warns
+    size_t count = dfa.getStateCount();
+    vector<bool> targeted(count, false);
+    for (size_t id = 1; id < count; id++) {
+        for (int c = 0; c < 256; c++) {
+            targeted[dfa.next((uint16_t)id, (unsigned char)c)] = true;
+        }
+    }
+    for (int c = 0; c < 256; c++) {
+        targeted[dfa.next(dfa.getStartId(), (unsigned char)c)] = true;
+    }
+
+    for (size_t id = 1; id < count; id++) {
+        if (dfa.isAccepting((uint16_t)id) && dfa.getStateTag((uint16_t)id) == STATE_UNMAPPED) {
+            fprintf(stderr, "%s: accepting state %s has no token type\n", argv[0], dfa.getStateName((uint16_t)id).c_str());
+            return 1;
+        }
+    }
+
+    FILE* out = fopen(argv[2], "w");
+    if (out == NULL) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    fprintf(out, "// Generated by tools/gen_direct_lexer.cpp from %s. Do not edit.\n\n", rulesFile);
+    fprintf(out, "#include \"../include/direct_lexer.h\"\n\n");
+    fprintf(out, "using namespace std;\n\n");
+
+    // Runs that self-looping states skip with a vector scan
+    for (size_t id = 1; id < count; id++) {
+        const StopBytes* stops = dfa.getLoopStops((uint16_t)id);
+        if (stops == nullptr || !targeted[id]) continue;
+        fprintf(out, "static const StopBytes STOPS_%zu(%s, %s, %s, %s, %s, %s, %s);\n", id,
+                charLiteral(stops->bytes[0]).c_str(), charLiteral(stops->bytes[1]).c_str(),
+                charLiteral(stops->bytes[2]).c_str(), charLiteral(stops->passes[0]).c_str(),
+                charLiteral(stops->passes[1]).c_str(), charLiteral(stops->passes[2]).c_str(),
+                stops->passHigh ? "true" : "false");
+    }
+
+    fprintf(out, "\nint directMatch(const char* p, const char* end, const char*& lastFinalPos, const char*& stop) {\n");
+    fprintf(out, "    int tag = STATE_NO_MATCH;\n");
+    fprintf(out, "    lastFinalPos = p;\n\n");
+
+    // The start state is entered without consuming a byte or accepting
+    fprintf(out, "    // %s\n", dfa.getStateName(dfa.getStartId()).c_str());
+    writeSwitch(out, dfa, dfa.getStartId());
+
+    for (size_t id = 1; id < count; id++) {
+        if (!targeted[id]) continue;
+        uint16_t state = (uint16_t)id;
+        fprintf(out, "S%zu: // %s\n", id, dfa.getStateName(state).c_str());
+        if (dfa.getLoopStops(state) != nullptr) {
+            fprintf(out, "    p = findStop(STOPS_%zu, p, end);\n", id);
+        }
+        if (dfa.isAccepting(state)) {
+            fprintf(out, "    tag = %s;\n", tagName(dfa.getStateTag(state)).c_str());
+            fprintf(out, "    lastFinalPos = p;\n");
+        }
+        // Terminal states commit without looking at the next byte
+        if (dfa.getFlags(state) & DFA::STATE_TERMINAL) {
+            fprintf(out, "    goto done;\n\n");
+            continue;
+        }
+        writeSwitch(out, dfa, state);
+    }
+
+    fprintf(out, "done:\n");
+    fprintf(out, "    stop = p;\n");
+    fprintf(out, "    return tag;\n");
+    fprintf(out, "}\n\n");
+
+    const vector<pair<string, Type>>& words = dfa.getReservedWords();
+    fprintf(out, "const ReservedWord DIRECT_RESERVED_WORDS[] = {\n");
+    for (const auto& word : words) {
+        fprintf(out, "    {\"%s\", %s},\n", word.first.c_str(), typeToString(word.second));
+    }
+    fprintf(out, "    {nullptr, KEYWORD}\n};\n");
+    fprintf(out, "const size_t DIRECT_RESERVED_WORD_COUNT = %zu;\n", words.size());
+    fprintf(out, "const char* const DIRECT_RULES_FILE = \"%s\";\n", rulesFile);
+    fprintf(out, "const uint64_t DIRECT_RULES_FINGERPRINT = 0x%016llxULL;\n", (unsigned long long)dfa.fingerprint());
+
+    if (fclose(out) != 0) {
+        perror(argv[2]);
+        return 1;
+    }
+    return 0;
+}
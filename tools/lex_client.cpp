@@ -0,0 +1,88 @@
+// Minimal client for `compiler --serve=SOCK`: lexes each file (or stdin
+// for "-") on the server and prints the tokens as if the compiler had.
+//
+//   lex_client <socket> <file|->...
+//
+// Tokens go to stdout and diagnostics to stderr. Exit status is 0 if every
+// file lexed cleanly, 1 otherwise.
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../src/include/protocol.h"
+
+using namespace std;
+
+static int connectTo(const char* path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        cerr << "Socket path too long: " << path << endl;
+        return -1;
+    }
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        perror("Error connecting to server");
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " <socket> <file|->..." << endl;
+        return 1;
+    }
+
+    int server = connectTo(argv[1]);
+    if (server < 0) {
+        return 1;
+    }
+
+    int status = 0;
+    string request;
+    string response;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "-") == 0) {
+            request.assign(1, (char)LEX_SOURCE);
+            request.append(istreambuf_iterator<char>(cin), istreambuf_iterator<char>());
+        } else {
+            // The server has its own working directory
+            char resolved[PATH_MAX];
+            request.assign(1, (char)LEX_PATH);
+            request += realpath(argv[i], resolved) ? resolved : argv[i];
+        }
+
+        if (request.size() > MAX_FRAME_SIZE) {
+            cerr << argv[i] << ": request larger than " << (MAX_FRAME_SIZE >> 20) << " MiB" << endl;
+            status = 1;
+            continue;
+        }
+        if (!writeFrame(server, request.data(), request.size()) || !readFrame(server, response) ||
+            response.size() < 5) {
+            cerr << "Lost connection to server" << endl;
+            close(server);
+            return 1;
+        }
+
+        uint32_t tokenBytes = getUint32((const unsigned char*)response.data() + 1);
+        if (tokenBytes > response.size() - 5) tokenBytes = (uint32_t)(response.size() - 5);
+        fwrite(response.data() + 5, 1, tokenBytes, stdout);
+        fwrite(response.data() + 5 + tokenBytes, 1, response.size() - 5 - tokenBytes, stderr);
+        if (response[0] != LEX_OK) status = 1;
+    }
+
+    close(server);
+    return status;
+}